@@ -0,0 +1,192 @@
+#include "BenchmarkSuite.h"
+#include "StringGenerator.h"
+#include "StringSortTester.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <functional>
+#include <thread>
+#include <ctime>
+
+// Флаги компиляции и ревизия git подставляются Makefile при сборке BenchmarkSuite.o
+#ifndef BUILD_CXXFLAGS
+#define BUILD_CXXFLAGS "unknown"
+#endif
+#ifndef BUILD_GIT_REVISION
+#define BUILD_GIT_REVISION "unknown"
+#endif
+
+const int BenchmarkSuite::BENCH_SIZES[] = {1000, 3000};
+const int BenchmarkSuite::NUM_BENCH_SIZES = sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]);
+
+BenchmarkSuite::BenchmarkSuite(unsigned int seed, int repetitions)
+    : seed(seed), repetitions(repetitions)
+{
+}
+
+std::string BenchmarkSuite::readCPUModel()
+{
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+    {
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos)
+            {
+                return line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+        }
+    }
+    return "unknown";
+}
+
+std::string BenchmarkSuite::currentTimestamp()
+{
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+std::string BenchmarkSuite::escapeJSON(const std::string &value)
+{
+    std::string escaped;
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            escaped += ' ';
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void BenchmarkSuite::run()
+{
+    StringGenerator generator(seed);
+
+    std::vector<std::pair<std::string, std::function<SortResult(std::vector<std::string>)>>> algorithms = {
+        {"QuickSort", StringSortTester::testQuickSort},
+        {"MergeSort", StringSortTester::testMergeSort},
+        {"StringQuickSort", StringSortTester::testStringQuickSort},
+        {"StringMergeSort", StringSortTester::testStringMergeSort},
+        {"MSDRadixSort", StringSortTester::testMSDRadixSort},
+        {"MSDRadixSortWithQuickSort", StringSortTester::testMSDRadixSortWithQuickSort}};
+
+    cells.clear();
+
+    // Порядок генерации фиксирован, поэтому при одном зерне данные совпадают
+    std::vector<std::pair<int, std::vector<std::pair<std::string, std::vector<std::string>>>>> datasets;
+    for (int s = 0; s < NUM_BENCH_SIZES; ++s)
+    {
+        int size = BENCH_SIZES[s];
+        datasets.push_back({size,
+                            {{"Random", generator.generateRandomArray(size)},
+                             {"ReverseSorted", generator.generateReverseSortedArray(size)},
+                             {"NearlySorted", generator.generateNearlySortedArray(size)},
+                             {"PrefixBased", generator.generatePrefixBasedArray(size)},
+                             {"HighDuplicate", generator.generateHighDuplicateArray(size)}}});
+    }
+
+    for (const auto &sized : datasets)
+    {
+        for (const auto &data_pair : sized.second)
+        {
+            for (const auto &algo_pair : algorithms)
+            {
+                cells.push_back({algo_pair.first, sized.first, data_pair.first, {}, 0, true});
+            }
+        }
+    }
+
+    // Повторы идут по кругу через все ячейки: дрейф состояния машины за время
+    // прогона попадает в разброс каждой ячейки, а не смещает отдельные ячейки
+    for (int r = 0; r < repetitions; ++r)
+    {
+        std::cout << "Повтор " << (r + 1) << " из " << repetitions << std::endl;
+
+        size_t c = 0;
+        for (const auto &sized : datasets)
+        {
+            for (const auto &data_pair : sized.second)
+            {
+                for (const auto &algo_pair : algorithms)
+                {
+                    Cell &cell = cells[c++];
+                    SortResult result = algo_pair.second(data_pair.second);
+                    cell.time_ms.push_back(result.execution_time_ms);
+                    cell.character_comparisons = result.character_comparisons;
+                    cell.is_sorted = cell.is_sorted && result.is_sorted && result.is_permutation;
+                }
+            }
+        }
+    }
+
+    for (const auto &cell : cells)
+    {
+        if (!cell.is_sorted)
+        {
+            std::cerr << "Ошибка сортировки: " << cell.algorithm << " / " << cell.array_type
+                      << " / " << cell.array_size << std::endl;
+        }
+    }
+}
+
+void BenchmarkSuite::writeJSON(std::ostream &out) const
+{
+    out << "{\n";
+    out << "  \"metadata\": {\n";
+    out << "    \"cpu_model\": \"" << escapeJSON(readCPUModel()) << "\",\n";
+    out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef __VERSION__
+    out << "    \"compiler\": \"" << escapeJSON(__VERSION__) << "\",\n";
+#endif
+    out << "    \"compiler_flags\": \"" << escapeJSON(BUILD_CXXFLAGS) << "\",\n";
+    out << "    \"git_revision\": \"" << escapeJSON(BUILD_GIT_REVISION) << "\",\n";
+    out << "    \"timestamp\": \"" << currentTimestamp() << "\",\n";
+    out << "    \"seed\": " << seed << ",\n";
+    out << "    \"repetitions\": " << repetitions << "\n";
+    out << "  },\n";
+    out << "  \"results\": [\n";
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        const Cell &cell = cells[i];
+        out << "    {\"algorithm\": \"" << cell.algorithm << "\", "
+            << "\"array_size\": " << cell.array_size << ", "
+            << "\"array_type\": \"" << cell.array_type << "\", "
+            << "\"character_comparisons\": " << cell.character_comparisons << ", "
+            << "\"is_sorted\": " << (cell.is_sorted ? "true" : "false") << ", "
+            << "\"time_ms\": [";
+        for (size_t r = 0; r < cell.time_ms.size(); ++r)
+        {
+            out << (r ? ", " : "") << std::fixed << std::setprecision(3) << cell.time_ms[r];
+        }
+        out << "]}" << (i + 1 < cells.size() ? "," : "") << "\n";
+    }
+
+    out << "  ]\n";
+    out << "}\n";
+}
+
+bool BenchmarkSuite::saveJSON(const std::string &path) const
+{
+    std::ofstream json_file(path);
+    if (!json_file)
+    {
+        return false;
+    }
+    writeJSON(json_file);
+    return static_cast<bool>(json_file);
+}
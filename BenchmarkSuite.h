@@ -0,0 +1,49 @@
+#ifndef BENCHMARK_SUITE_H
+#define BENCHMARK_SUITE_H
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+// Набор для отслеживания регрессий: фиксированное подмножество сетки
+// (размеры, типы данных, алгоритмы) с заданным зерном генератора.
+// Каждая ячейка измеряется несколько раз, все замеры сохраняются в JSON
+// вместе с описанием машины для последующего сравнения с базовой линией
+class BenchmarkSuite
+{
+private:
+    struct Cell
+    {
+        std::string algorithm;
+        int array_size;
+        std::string array_type;
+        std::vector<double> time_ms;
+        long long character_comparisons;
+        bool is_sorted;
+    };
+
+    unsigned int seed;
+    int repetitions;
+    std::vector<Cell> cells;
+
+    static std::string readCPUModel();
+    static std::string currentTimestamp();
+    static std::string escapeJSON(const std::string &value);
+
+    void writeJSON(std::ostream &out) const;
+
+public:
+    static const int BENCH_SIZES[];
+    static const int NUM_BENCH_SIZES;
+    static const int DEFAULT_REPETITIONS = 20;
+    static const unsigned int DEFAULT_SEED = 42;
+
+    explicit BenchmarkSuite(unsigned int seed = DEFAULT_SEED, int repetitions = DEFAULT_REPETITIONS);
+
+    void run();
+
+    // Возвращает false, если файл не удалось записать
+    bool saveJSON(const std::string &path) const;
+};
+
+#endif // BENCHMARK_SUITE_H
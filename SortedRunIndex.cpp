@@ -0,0 +1,227 @@
+#include "SortedRunIndex.h"
+#include "StringSortTester.h"
+#include <algorithm>
+#include <queue>
+
+SortedRunIndex::SortedRunIndex() : total_size(0)
+{
+}
+
+std::vector<int> SortedRunIndex::buildLCP(const std::vector<std::string> &keys)
+{
+    std::vector<int> lcp(keys.size(), 0);
+
+    for (size_t i = 1; i < keys.size(); ++i)
+    {
+        const std::string &a = keys[i - 1];
+        const std::string &b = keys[i];
+        size_t min_len = std::min(a.length(), b.length());
+        size_t l = 0;
+        while (l < min_len && a[l] == b[l])
+        {
+            l++;
+        }
+        lcp[i] = static_cast<int>(l);
+    }
+
+    return lcp;
+}
+
+// h_a и h_b - LCP текущих строк прогонов с последней выведенной строкой.
+// Если h_a > h_b, строка older меньше и LCP newer с ней остается h_b.
+// При равенстве символы сравниваются начиная с h, и большая строка
+// получает найденную длину общего префикса
+SortedRunIndex::Run SortedRunIndex::mergeRuns(Run &older, Run &newer)
+{
+    Run merged;
+    size_t na = older.keys.size(), nb = newer.keys.size();
+    merged.keys.reserve(na + nb);
+    merged.lcp.reserve(na + nb);
+
+    size_t i = 0, j = 0;
+    int ha = 0, hb = 0;
+
+    while (i < na && j < nb)
+    {
+        bool take_older;
+
+        if (ha != hb)
+        {
+            take_older = ha > hb;
+        }
+        else
+        {
+            const std::string &a = older.keys[i];
+            const std::string &b = newer.keys[j];
+            size_t min_len = std::min(a.length(), b.length());
+            size_t h = ha;
+            while (h < min_len && a[h] == b[h])
+            {
+                h++;
+            }
+
+            // При равенстве строк первой выводится строка из старого прогона
+            take_older = h == min_len ? a.length() <= b.length()
+                                      : static_cast<unsigned char>(a[h]) < static_cast<unsigned char>(b[h]);
+            if (take_older)
+            {
+                hb = static_cast<int>(h);
+            }
+            else
+            {
+                ha = static_cast<int>(h);
+            }
+        }
+
+        if (take_older)
+        {
+            merged.lcp.push_back(ha);
+            merged.keys.push_back(std::move(older.keys[i]));
+            ++i;
+            ha = i < na ? older.lcp[i] : 0;
+        }
+        else
+        {
+            merged.lcp.push_back(hb);
+            merged.keys.push_back(std::move(newer.keys[j]));
+            ++j;
+            hb = j < nb ? newer.lcp[j] : 0;
+        }
+    }
+
+    // Для первой оставшейся строки LCP с последней выведенной уже известен
+    for (bool first = true; i < na; ++i, first = false)
+    {
+        merged.lcp.push_back(first ? ha : older.lcp[i]);
+        merged.keys.push_back(std::move(older.keys[i]));
+    }
+    for (bool first = true; j < nb; ++j, first = false)
+    {
+        merged.lcp.push_back(first ? hb : newer.lcp[j]);
+        merged.keys.push_back(std::move(newer.keys[j]));
+    }
+
+    if (!merged.lcp.empty())
+    {
+        merged.lcp[0] = 0;
+    }
+
+    return merged;
+}
+
+// Новый прогон сливается с предыдущим, пока тот не больше его, поэтому
+// каждая строка участвует в O(log n) слияниях
+void SortedRunIndex::compact()
+{
+    while (runs.size() >= 2 && runs[runs.size() - 2].keys.size() <= runs.back().keys.size())
+    {
+        Run newer = std::move(runs.back());
+        runs.pop_back();
+        runs.back() = mergeRuns(runs.back(), newer);
+    }
+}
+
+void SortedRunIndex::insertBatch(std::vector<std::string> batch)
+{
+    if (batch.empty())
+    {
+        return;
+    }
+
+    StringSortTester::sortBatch(batch);
+
+    Run run;
+    run.lcp = buildLCP(batch);
+    run.keys = std::move(batch);
+
+    total_size += run.keys.size();
+    runs.push_back(std::move(run));
+    compact();
+}
+
+size_t SortedRunIndex::size() const
+{
+    return total_size;
+}
+
+size_t SortedRunIndex::runCount() const
+{
+    return runs.size();
+}
+
+bool SortedRunIndex::contains(const std::string &key) const
+{
+    for (const auto &run : runs)
+    {
+        if (std::binary_search(run.keys.begin(), run.keys.end(), key))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// k-путевое слияние курсоров прогонов через кучу
+size_t SortedRunIndex::scanFrom(const std::string &from, const std::function<bool(const std::string &)> &visitor) const
+{
+    typedef std::pair<size_t, size_t> Cursor; // (прогон, позиция)
+
+    auto greater = [this](const Cursor &x, const Cursor &y)
+    {
+        return runs[x.first].keys[x.second] > runs[y.first].keys[y.second];
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(greater);
+
+    for (size_t r = 0; r < runs.size(); ++r)
+    {
+        const auto &keys = runs[r].keys;
+        size_t pos = std::lower_bound(keys.begin(), keys.end(), from) - keys.begin();
+        if (pos < keys.size())
+        {
+            heap.push({r, pos});
+        }
+    }
+
+    size_t visited = 0;
+    while (!heap.empty())
+    {
+        Cursor cursor = heap.top();
+        heap.pop();
+
+        visited++;
+        if (!visitor(runs[cursor.first].keys[cursor.second]))
+        {
+            break;
+        }
+
+        if (++cursor.second < runs[cursor.first].keys.size())
+        {
+            heap.push(cursor);
+        }
+    }
+
+    return visited;
+}
+
+std::vector<std::string> SortedRunIndex::firstK(size_t k) const
+{
+    std::vector<std::string> result;
+    result.reserve(std::min(k, total_size));
+
+    if (k == 0)
+    {
+        return result;
+    }
+
+    scanFrom("", [&](const std::string &key)
+             {
+        result.push_back(key);
+        return result.size() < k; });
+
+    return result;
+}
+
+std::vector<std::string> SortedRunIndex::snapshot() const
+{
+    return firstK(total_size);
+}
@@ -0,0 +1,57 @@
+#ifndef SORTED_RUN_INDEX_H
+#define SORTED_RUN_INDEX_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+// Инкрементальный упорядоченный индекс строк: каждая порция сортируется
+// существующим ядром и становится отсортированным прогоном, прогоны
+// сливаются с использованием LCP (по схеме LSM-дерева)
+class SortedRunIndex
+{
+private:
+    // lcp[i] - длина общего префикса keys[i - 1] и keys[i], lcp[0] = 0
+    struct Run
+    {
+        std::vector<std::string> keys;
+        std::vector<int> lcp;
+    };
+
+    // Прогоны от старых к новым; размеры строго убывают,
+    // поэтому прогонов не больше log2(size())
+    std::vector<Run> runs;
+    size_t total_size;
+
+    static std::vector<int> buildLCP(const std::vector<std::string> &keys);
+
+    // Слияние двух прогонов по LCP: при различных LCP с последней выведенной
+    // строкой порядок известен без чтения символов
+    static Run mergeRuns(Run &older, Run &newer);
+
+    void compact();
+
+public:
+    SortedRunIndex();
+
+    // Добавление порции строк в произвольном порядке
+    void insertBatch(std::vector<std::string> batch);
+
+    size_t size() const;
+    size_t runCount() const;
+
+    // Точечный запрос: бинарный поиск в каждом прогоне
+    bool contains(const std::string &key) const;
+
+    // Упорядоченный обход начиная с первой строки >= from; visitor возвращает
+    // false, чтобы остановить обход. Возвращает число посещенных строк
+    size_t scanFrom(const std::string &from, const std::function<bool(const std::string &)> &visitor) const;
+
+    // Первые k строк в порядке сортировки
+    std::vector<std::string> firstK(size_t k) const;
+
+    // Все строки в порядке сортировки
+    std::vector<std::string> snapshot() const;
+};
+
+#endif // SORTED_RUN_INDEX_H
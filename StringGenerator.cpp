@@ -13,6 +13,13 @@ StringGenerator::StringGenerator()
 {
 }
 
+StringGenerator::StringGenerator(unsigned int seed)
+    : gen(seed),
+      char_dist(0, ALPHABET.length() - 1),
+      length_dist(10, 200)
+{
+}
+
 std::string StringGenerator::generateRandomString(int min_length, int max_length)
 {
     std::uniform_int_distribution<int> len_dist(min_length, max_length);
@@ -86,6 +93,34 @@ std::vector<std::string> StringGenerator::generatePrefixBasedArray(int size, int
     return result;
 }
 
+std::vector<std::string> StringGenerator::generateHighDuplicateArray(int size, int distinct_keys)
+{
+    if (distinct_keys <= 0)
+    {
+        distinct_keys = std::max(1, size / 100);
+    }
+
+    std::vector<std::string> keys;
+    keys.reserve(distinct_keys);
+
+    for (int i = 0; i < distinct_keys; ++i)
+    {
+        keys.push_back(generateRandomString());
+    }
+
+    std::uniform_int_distribution<int> key_dist(0, distinct_keys - 1);
+
+    std::vector<std::string> result;
+    result.reserve(size);
+
+    for (int i = 0; i < size; ++i)
+    {
+        result.push_back(keys[key_dist(gen)]);
+    }
+
+    return result;
+}
+
 void StringGenerator::shuffleWithSwaps(std::vector<std::string> &arr, int num_swaps)
 {
     std::uniform_int_distribution<int> index_dist(0, arr.size() - 1);
@@ -18,6 +18,9 @@ private:
 public:
     StringGenerator();
 
+    // Воспроизводимая генерация с фиксированным зерном
+    explicit StringGenerator(unsigned int seed);
+
     // Генерация одной случайной строки
     std::string generateRandomString(int min_length = 10, int max_length = 200);
 
@@ -33,6 +36,10 @@ public:
     // Генерация массива строк с общими префиксами
     std::vector<std::string> generatePrefixBasedArray(int size, int prefix_length = 5);
 
+    // Генерация массива с большим числом повторов: size строк из distinct_keys
+    // различных ключей (по умолчанию size / 100)
+    std::vector<std::string> generateHighDuplicateArray(int size, int distinct_keys = 0);
+
     // Перемешивание массива с заданным количеством перестановок
     void shuffleWithSwaps(std::vector<std::string> &arr, int num_swaps);
 };
@@ -2,16 +2,67 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <fstream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <sys/resource.h>
+
+// Подсчет выделений памяти: глобальные operator new/delete заменены
+// счетчиком поверх malloc/free
+static std::atomic<long long> allocation_count(0);
+
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC не видит, что память выделена через malloc в замененном operator new
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#pragma GCC diagnostic pop
 
 long long StringSortTester::comparison_count = 0;
+long long StringSortTester::move_count = 0;
+long long StringSortTester::bytes_moved = 0;
+long long StringSortTester::bytes_read = 0;
+bool StringSortTester::verification_enabled = true;
+
+void StringSortTester::setVerification(bool enabled)
+{
+    verification_enabled = enabled;
+}
+
+bool StringSortTester::isVerificationEnabled()
+{
+    return verification_enabled;
+}
 
-int StringSortTester::compareStrings(const std::string &a, const std::string &b)
+int StringSortTester::compareStrings(const std::string &a, const std::string &b, int depth)
 {
     size_t min_len = std::min(a.length(), b.length());
 
-    for (size_t i = 0; i < min_len; ++i)
+    for (size_t i = depth; i < min_len; ++i)
     {
         comparison_count++;
+        bytes_read += 2;
         if (a[i] < b[i])
             return -1;
         if (a[i] > b[i])
@@ -25,20 +76,300 @@ int StringSortTester::compareStrings(const std::string &a, const std::string &b)
     return 0;
 }
 
+void StringSortTester::moveString(std::string &dst, const std::string &src)
+{
+    move_count++;
+    bytes_moved += src.length();
+    dst = src;
+}
+
+// Обмен учитывается как два перемещения: в трафик входят обе строки,
+// хотя std::swap переставляет только указатели
+void StringSortTester::swapStrings(std::string &a, std::string &b)
+{
+    move_count += 2;
+    bytes_moved += a.length() + b.length();
+    std::swap(a, b);
+}
+
+// Нагрузка переносится вместе с ключом и учитывается в трафике
+void StringSortTester::moveRecord(KeyValueArray &dst, int i, const KeyValueArray &src, int j)
+{
+    moveString(dst.keys[i], src.keys[j]);
+    dst.payloads[i] = src.payloads[j];
+    bytes_moved += sizeof(uint64_t);
+}
+
+void StringSortTester::swapRecords(KeyValueArray &arr, int i, int j)
+{
+    swapStrings(arr.keys[i], arr.keys[j]);
+    std::swap(arr.payloads[i], arr.payloads[j]);
+    bytes_moved += 2 * sizeof(uint64_t);
+}
+
+const std::string &StringSortTester::keyAt(const std::vector<std::string> &arr, int i)
+{
+    return arr[i];
+}
+
+const std::string &StringSortTester::keyAt(const KeyValueArray &arr, int i)
+{
+    return arr.keys[i];
+}
+
+void StringSortTester::moveElement(std::vector<std::string> &dst, int i, const std::vector<std::string> &src, int j)
+{
+    moveString(dst[i], src[j]);
+}
+
+void StringSortTester::moveElement(KeyValueArray &dst, int i, const KeyValueArray &src, int j)
+{
+    moveRecord(dst, i, src, j);
+}
+
+void StringSortTester::swapElements(std::vector<std::string> &arr, int i, int j)
+{
+    swapStrings(arr[i], arr[j]);
+}
+
+void StringSortTester::swapElements(KeyValueArray &arr, int i, int j)
+{
+    swapRecords(arr, i, j);
+}
+
+std::vector<std::string> StringSortTester::makeBuffer(const std::vector<std::string> &, int n)
+{
+    return std::vector<std::string>(n);
+}
+
+KeyValueArray StringSortTester::makeBuffer(const KeyValueArray &, int n)
+{
+    return KeyValueArray{std::vector<std::string>(n), std::vector<uint64_t>(n)};
+}
+
+void StringSortTester::parallelFor(size_t n, const std::function<void(size_t, size_t)> &body)
+{
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (n < PARALLEL_VERIFY_THRESHOLD || num_threads == 1)
+    {
+        body(0, n);
+        return;
+    }
+
+    size_t chunk = (n + num_threads - 1) / num_threads;
+    std::vector<std::thread> workers;
+    for (size_t begin = 0; begin < n; begin += chunk)
+    {
+        workers.emplace_back(body, begin, std::min(n, begin + chunk));
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Каждый блок проверяет пары (i - 1, i) внутри своих границ, поэтому
+// стыки между блоками тоже покрыты
 bool StringSortTester::isSorted(const std::vector<std::string> &arr)
 {
-    for (size_t i = 1; i < arr.size(); ++i)
+    std::atomic<bool> sorted(true);
+
+    parallelFor(arr.size(), [&](size_t begin, size_t end)
+                {
+        for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+        {
+            if (arr[i - 1].compare(arr[i]) > 0)
+            {
+                sorted.store(false, std::memory_order_relaxed);
+                return;
+            }
+            if ((i & 4095) == 0 && !sorted.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+        } });
+
+    return sorted.load();
+}
+
+// Нагрузка равна исходной позиции, поэтому у равных ключей она должна возрастать
+bool StringSortTester::isStable(const KeyValueArray &arr)
+{
+    std::atomic<bool> stable(true);
+
+    parallelFor(arr.keys.size(), [&](size_t begin, size_t end)
+                {
+        for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+        {
+            if (arr.keys[i - 1] == arr.keys[i] && arr.payloads[i - 1] > arr.payloads[i])
+            {
+                stable.store(false, std::memory_order_relaxed);
+                return;
+            }
+        } });
+
+    return stable.load();
+}
+
+bool StringSortTester::isPartiallySorted(const std::vector<std::string> &arr, int k)
+{
+    if (k <= 0)
     {
-        if (arr[i - 1] > arr[i])
+        return true;
+    }
+
+    size_t prefix = std::min(arr.size(), static_cast<size_t>(k));
+    const std::string &boundary = arr[prefix - 1];
+    std::atomic<bool> valid(true);
+
+    parallelFor(arr.size(), [&](size_t begin, size_t end)
+                {
+        for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
         {
-            return false;
+            bool ok = i < prefix ? arr[i - 1].compare(arr[i]) <= 0 : boundary.compare(arr[i]) <= 0;
+            if (!ok)
+            {
+                valid.store(false, std::memory_order_relaxed);
+                return;
+            }
+        } });
+
+    return valid.load();
+}
+
+bool StringSortTester::isNthElement(const std::vector<std::string> &arr, int rank)
+{
+    if (rank < 0 || rank >= static_cast<int>(arr.size()))
+    {
+        return true;
+    }
+
+    const std::string &nth = arr[rank];
+    std::atomic<bool> valid(true);
+
+    parallelFor(arr.size(), [&](size_t begin, size_t end)
+                {
+        for (size_t i = begin; i < end; ++i)
+        {
+            int cmp = arr[i].compare(nth);
+            if ((i < static_cast<size_t>(rank) && cmp > 0) || (i > static_cast<size_t>(rank) && cmp < 0))
+            {
+                valid.store(false, std::memory_order_relaxed);
+                return;
+            }
+        } });
+
+    return valid.load();
+}
+
+unsigned long long StringSortTester::mix64(unsigned long long h)
+{
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+// Хеш по 8 байт за шаг с финализацией splitmix64
+unsigned long long StringSortTester::hashString(const std::string &s)
+{
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ s.length();
+    size_t i = 0;
+
+    for (; i + 8 <= s.length(); i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, s.data() + i, 8);
+        h = (h ^ word) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, s.data() + i, s.length() - i);
+    h = (h ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+
+    return mix64(h);
+}
+
+// Сумма и XOR хешей не зависят от порядка, поэтому потерянная или
+// продублированная строка меняет отпечаток при любой перестановке
+MultisetFingerprint StringSortTester::computeFingerprint(const std::vector<std::string> &arr)
+{
+    std::atomic<unsigned long long> hash_sum(0);
+    std::atomic<unsigned long long> hash_xor(0);
+
+    parallelFor(arr.size(), [&](size_t begin, size_t end)
+                {
+        unsigned long long local_sum = 0;
+        unsigned long long local_xor = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned long long h = hashString(arr[i]);
+            local_sum += h;
+            local_xor ^= h;
         }
+        hash_sum.fetch_add(local_sum);
+        hash_xor.fetch_xor(local_xor); });
+
+    return {arr.size(), hash_sum.load(), hash_xor.load()};
+}
+
+// Хешируется пара (ключ, нагрузка): перенос нагрузки к чужому ключу
+// меняет отпечаток так же, как потеря записи
+MultisetFingerprint StringSortTester::computeFingerprint(const KeyValueArray &arr)
+{
+    std::atomic<unsigned long long> hash_sum(0);
+    std::atomic<unsigned long long> hash_xor(0);
+
+    parallelFor(arr.keys.size(), [&](size_t begin, size_t end)
+                {
+        unsigned long long local_sum = 0;
+        unsigned long long local_xor = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned long long h = mix64(hashString(arr.keys[i]) ^ mix64(arr.payloads[i] + 0x9E3779B97F4A7C15ULL));
+            local_sum += h;
+            local_xor ^= h;
+        }
+        hash_sum.fetch_add(local_sum);
+        hash_xor.fetch_xor(local_xor); });
+
+    return {arr.keys.size(), hash_sum.load(), hash_xor.load()};
+}
+
+// Запись "5" в clear_refs сбрасывает VmHWM (Linux >= 4.0);
+// при недоступности остается пик за все время процесса
+void StringSortTester::resetPeakRSS()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs)
+    {
+        clear_refs << "5";
     }
-    return true;
+}
+
+long StringSortTester::readPeakRSS()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
 }
 
 // Стандартная быстрая сортировка
-void StringSortTester::quickSort(std::vector<std::string> &arr, int low, int high)
+template <typename Array>
+void StringSortTester::quickSort(Array &arr, int low, int high)
 {
     if (low < high)
     {
@@ -48,25 +379,29 @@ void StringSortTester::quickSort(std::vector<std::string> &arr, int low, int hig
     }
 }
 
-int StringSortTester::partition(std::vector<std::string> &arr, int low, int high)
+// Опорный ключ берется по ссылке: позиция high не меняется до последнего обмена
+template <typename Array>
+int StringSortTester::partition(Array &arr, int low, int high)
 {
-    std::string pivot = arr[high];
+    const std::string &pivot = keyAt(arr, high);
     int i = low - 1;
 
     for (int j = low; j < high; ++j)
     {
-        if (compareStrings(arr[j], pivot) <= 0)
+        if (compareStrings(keyAt(arr, j), pivot) <= 0)
         {
             ++i;
-            std::swap(arr[i], arr[j]);
+            swapElements(arr, i, j);
         }
     }
-    std::swap(arr[i + 1], arr[high]);
+    swapElements(arr, i + 1, high);
     return i + 1;
 }
 
-// Стандартная сортировка слиянием
-void StringSortTester::mergeSort(std::vector<std::string> &arr, int left, int right)
+// Стандартная сортировка слиянием. Устойчива: при равенстве ключей
+// первым берется элемент из левой половины
+template <typename Array>
+void StringSortTester::mergeSort(Array &arr, int left, int right)
 {
     if (left < right)
     {
@@ -77,34 +412,35 @@ void StringSortTester::mergeSort(std::vector<std::string> &arr, int left, int ri
     }
 }
 
-void StringSortTester::merge(std::vector<std::string> &arr, int left, int mid, int right)
+template <typename Array>
+void StringSortTester::merge(Array &arr, int left, int mid, int right)
 {
     int n1 = mid - left + 1;
     int n2 = right - mid;
 
-    std::vector<std::string> L(n1), R(n2);
+    Array L = makeBuffer(arr, n1), R = makeBuffer(arr, n2);
 
     for (int i = 0; i < n1; ++i)
     {
-        L[i] = arr[left + i];
+        moveElement(L, i, arr, left + i);
     }
     for (int j = 0; j < n2; ++j)
     {
-        R[j] = arr[mid + 1 + j];
+        moveElement(R, j, arr, mid + 1 + j);
     }
 
     int i = 0, j = 0, k = left;
 
     while (i < n1 && j < n2)
     {
-        if (compareStrings(L[i], R[j]) <= 0)
+        if (compareStrings(keyAt(L, i), keyAt(R, j)) <= 0)
         {
-            arr[k] = L[i];
+            moveElement(arr, k, L, i);
             ++i;
         }
         else
         {
-            arr[k] = R[j];
+            moveElement(arr, k, R, j);
             ++j;
         }
         ++k;
@@ -112,14 +448,14 @@ void StringSortTester::merge(std::vector<std::string> &arr, int left, int mid, i
 
     while (i < n1)
     {
-        arr[k] = L[i];
+        moveElement(arr, k, L, i);
         ++i;
         ++k;
     }
 
     while (j < n2)
     {
-        arr[k] = R[j];
+        moveElement(arr, k, R, j);
         ++j;
         ++k;
     }
@@ -132,6 +468,7 @@ int StringSortTester::charAt(const std::string &s, int index)
     {
         return -1; // Конец строки
     }
+    bytes_read++;
     return static_cast<unsigned char>(s[index]);
 }
 
@@ -144,6 +481,7 @@ int StringSortTester::getLCP(const std::string &a, const std::string &b, int dep
     for (size_t i = depth; i < min_len; ++i)
     {
         comparison_count++;
+        bytes_read += 2;
         if (a[i] != b[i])
             break;
         lcp++;
@@ -152,28 +490,65 @@ int StringSortTester::getLCP(const std::string &a, const std::string &b, int dep
     return lcp;
 }
 
-// Тернарная быстрая сортировка строк
-void StringSortTester::ternaryStringQuickSort(std::vector<std::string> &arr, int low, int high, int depth)
+// Подсчет частот символа на позиции depth и вычисление начал корзин
+template <typename Array>
+std::vector<int> StringSortTester::countByChar(const Array &arr, int low, int high, int depth)
 {
-    if (high <= low)
-        return;
+    std::vector<int> bucket(RADIX + 2, 0);
+
+    for (int i = low; i <= high; ++i)
+    {
+        int ch = charAt(keyAt(arr, i), depth);
+        bucket[ch + 2]++;
+        comparison_count++;
+    }
+
+    for (int b = 0; b < RADIX + 1; ++b)
+    {
+        bucket[b + 1] += bucket[b];
+    }
+
+    return bucket;
+}
+
+// Распределение подсчетом сохраняет относительный порядок внутри корзины
+template <typename Array>
+void StringSortTester::distributeByChar(Array &arr, int low, int high, int depth, const std::vector<int> &bucket)
+{
+    std::vector<int> next(bucket.begin(), bucket.end() - 1);
+    Array aux = makeBuffer(arr, high - low + 1);
+
+    for (int i = low; i <= high; ++i)
+    {
+        int ch = charAt(keyAt(arr, i), depth);
+        moveElement(aux, next[ch + 1]++, arr, i);
+    }
 
+    for (int i = low; i <= high; ++i)
+    {
+        moveElement(arr, i, aux, i - low);
+    }
+}
+
+template <typename Array>
+StringSortTester::CharPartition StringSortTester::partitionByChar(Array &arr, int low, int high, int depth)
+{
     int lt = low, gt = high;
-    int pivot = charAt(arr[low], depth);
+    int pivot = charAt(keyAt(arr, low), depth);
     int i = low + 1;
 
     while (i <= gt)
     {
-        int ch = charAt(arr[i], depth);
+        int ch = charAt(keyAt(arr, i), depth);
         comparison_count++;
 
         if (ch < pivot)
         {
-            std::swap(arr[lt++], arr[i++]);
+            swapElements(arr, lt++, i++);
         }
         else if (ch > pivot)
         {
-            std::swap(arr[i], arr[gt--]);
+            swapElements(arr, i, gt--);
         }
         else
         {
@@ -181,16 +556,29 @@ void StringSortTester::ternaryStringQuickSort(std::vector<std::string> &arr, int
         }
     }
 
-    ternaryStringQuickSort(arr, low, lt - 1, depth);
-    if (pivot >= 0)
+    return {lt, gt, pivot};
+}
+
+// Тернарная быстрая сортировка строк
+template <typename Array>
+void StringSortTester::ternaryStringQuickSort(Array &arr, int low, int high, int depth)
+{
+    if (high <= low)
+        return;
+
+    CharPartition part = partitionByChar(arr, low, high, depth);
+
+    ternaryStringQuickSort(arr, low, part.lt - 1, depth);
+    if (part.pivot >= 0)
     {
-        ternaryStringQuickSort(arr, lt, gt, depth + 1);
+        ternaryStringQuickSort(arr, part.lt, part.gt, depth + 1);
     }
-    ternaryStringQuickSort(arr, gt + 1, high, depth);
+    ternaryStringQuickSort(arr, part.gt + 1, high, depth);
 }
 
 // String MergeSort с использованием LCP
-void StringSortTester::stringMergeSort(std::vector<std::string> &arr, int left, int right, int depth)
+template <typename Array>
+void StringSortTester::stringMergeSort(Array &arr, int left, int right, int depth)
 {
     if (left < right)
     {
@@ -201,20 +589,21 @@ void StringSortTester::stringMergeSort(std::vector<std::string> &arr, int left,
     }
 }
 
-void StringSortTester::stringMergeWithLCP(std::vector<std::string> &arr, int left, int mid, int right, int depth)
+template <typename Array>
+void StringSortTester::stringMergeWithLCP(Array &arr, int left, int mid, int right, int depth)
 {
     int n1 = mid - left + 1;
     int n2 = right - mid;
 
-    std::vector<std::string> L(n1), R(n2);
+    Array L = makeBuffer(arr, n1), R = makeBuffer(arr, n2);
 
     for (int i = 0; i < n1; ++i)
     {
-        L[i] = arr[left + i];
+        moveElement(L, i, arr, left + i);
     }
     for (int j = 0; j < n2; ++j)
     {
-        R[j] = arr[mid + 1 + j];
+        moveElement(R, j, arr, mid + 1 + j);
     }
 
     int i = 0, j = 0, k = left;
@@ -222,14 +611,14 @@ void StringSortTester::stringMergeWithLCP(std::vector<std::string> &arr, int lef
     while (i < n1 && j < n2)
     {
         // Используем стандартное сравнение строк с подсчетом сравнений
-        if (compareStrings(L[i], R[j]) <= 0)
+        if (compareStrings(keyAt(L, i), keyAt(R, j)) <= 0)
         {
-            arr[k] = L[i];
+            moveElement(arr, k, L, i);
             ++i;
         }
         else
         {
-            arr[k] = R[j];
+            moveElement(arr, k, R, j);
             ++j;
         }
         ++k;
@@ -237,161 +626,639 @@ void StringSortTester::stringMergeWithLCP(std::vector<std::string> &arr, int lef
 
     while (i < n1)
     {
-        arr[k] = L[i];
+        moveElement(arr, k, L, i);
         ++i;
         ++k;
     }
 
     while (j < n2)
     {
-        arr[k] = R[j];
+        moveElement(arr, k, R, j);
         ++j;
         ++k;
     }
 }
 
-// MSD Radix Sort
-void StringSortTester::msdRadixSort(std::vector<std::string> &arr, int low, int high, int depth)
+// MSD Radix Sort. Распределение подсчетом устойчиво, поэтому
+// в режиме "ключ - нагрузка" сортировка тоже устойчива
+template <typename Array>
+void StringSortTester::msdRadixSort(Array &arr, int low, int high, int depth)
 {
     if (high <= low)
         return;
 
-    const int R = 256; // Размер алфавита ASCII
-    std::vector<int> count(R + 2, 0);
-    std::vector<std::string> aux(high - low + 1);
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+    distributeByChar(arr, low, high, depth, bucket);
 
-    // Подсчет частот
-    for (int i = low; i <= high; ++i)
+    // Рекурсивная сортировка для каждого символа
+    for (int b = 1; b <= RADIX; ++b)
     {
-        int ch = charAt(arr[i], depth);
-        count[ch + 2]++;
-        comparison_count++;
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
+        if (start < end)
+        {
+            msdRadixSort(arr, start, end, depth + 1);
+        }
     }
+}
+
+// MSD Radix Sort с переключением на String QuickSort
+// (неустойчива из-за тернарного разбиения)
+template <typename Array>
+void StringSortTester::msdRadixSortWithQuickSort(Array &arr, int low, int high, int depth)
+{
+    if (high <= low)
+        return;
 
-    // Вычисление позиций
-    for (int r = 0; r < R + 1; ++r)
+    // Переключаемся на String QuickSort если размер массива меньше размера алфавита
+    if (high - low + 1 < ALPHABET_SIZE)
     {
-        count[r + 1] += count[r];
+        ternaryStringQuickSort(arr, low, high, depth);
+        return;
     }
 
-    // Распределение
-    for (int i = low; i <= high; ++i)
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+    distributeByChar(arr, low, high, depth, bucket);
+
+    for (int b = 1; b <= RADIX; ++b)
     {
-        int ch = charAt(arr[i], depth);
-        aux[count[ch + 1]++] = arr[i];
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
+        if (start < end)
+        {
+            msdRadixSortWithQuickSort(arr, start, end, depth + 1);
+        }
     }
+}
 
-    // Копирование обратно
-    for (int i = low; i <= high; ++i)
+// Устойчивый гибрид: малые корзины досортировываются вставками
+template <typename Array>
+void StringSortTester::msdRadixSortStable(Array &arr, int low, int high, int depth)
+{
+    if (high <= low)
+        return;
+
+    if (high - low + 1 < ALPHABET_SIZE)
     {
-        arr[i] = aux[i - low];
+        insertionSort(arr, low, high, depth);
+        return;
     }
 
-    // Рекурсивная сортировка для каждого символа
-    for (int r = 0; r < R; ++r)
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+    distributeByChar(arr, low, high, depth, bucket);
+
+    for (int b = 1; b <= RADIX; ++b)
     {
-        int start = low + count[r];
-        int end = low + count[r + 1] - 1;
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
         if (start < end)
         {
-            msdRadixSort(arr, start, end, depth + 1);
+            msdRadixSortStable(arr, start, end, depth + 1);
         }
     }
 }
 
-// MSD Radix Sort с переключением на String QuickSort
-void StringSortTester::msdRadixSortWithQuickSort(std::vector<std::string> &arr, int low, int high, int depth)
+// Ключи корзины совпадают в первых depth символах, сравнение начинается с depth.
+// Обмен только при строго большем ключе сохраняет устойчивость
+template <typename Array>
+void StringSortTester::insertionSort(Array &arr, int low, int high, int depth)
+{
+    for (int i = low + 1; i <= high; ++i)
+    {
+        for (int j = i; j > low && compareStrings(keyAt(arr, j - 1), keyAt(arr, j), depth) > 0; --j)
+        {
+            swapElements(arr, j - 1, j);
+        }
+    }
+}
+
+// Частичная тернарная сортировка: части, целиком лежащие правее k,
+// остаются неупорядоченными
+void StringSortTester::partialTernaryStringQuickSort(std::vector<std::string> &arr, int low, int high, int depth, int k)
+{
+    if (high <= low || low >= k)
+        return;
+
+    CharPartition part = partitionByChar(arr, low, high, depth);
+
+    partialTernaryStringQuickSort(arr, low, part.lt - 1, depth, k);
+    if (part.pivot >= 0)
+    {
+        partialTernaryStringQuickSort(arr, part.lt, part.gt, depth + 1, k);
+    }
+    partialTernaryStringQuickSort(arr, part.gt + 1, high, depth, k);
+}
+
+// Частичная MSD Radix Sort: корзины, начинающиеся не раньше k, не сортируются
+void StringSortTester::partialMsdRadixSort(std::vector<std::string> &arr, int low, int high, int depth, int k)
+{
+    if (high <= low || low >= k)
+        return;
+
+    if (high - low + 1 < ALPHABET_SIZE)
+    {
+        partialTernaryStringQuickSort(arr, low, high, depth, k);
+        return;
+    }
+
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+    distributeByChar(arr, low, high, depth, bucket);
+
+    for (int b = 1; b <= RADIX; ++b)
+    {
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
+        if (start >= k)
+        {
+            break;
+        }
+        if (start < end)
+        {
+            partialMsdRadixSort(arr, start, end, depth + 1, k);
+        }
+    }
+}
+
+void StringSortTester::nthElementTernary(std::vector<std::string> &arr, int low, int high, int depth, int rank)
+{
+    if (high <= low)
+        return;
+
+    CharPartition part = partitionByChar(arr, low, high, depth);
+
+    if (rank < part.lt)
+    {
+        nthElementTernary(arr, low, part.lt - 1, depth, rank);
+    }
+    else if (rank > part.gt)
+    {
+        nthElementTernary(arr, part.gt + 1, high, depth, rank);
+    }
+    else if (part.pivot >= 0)
+    {
+        nthElementTernary(arr, part.lt, part.gt, depth + 1, rank);
+    }
+}
+
+void StringSortTester::nthElementMsdRadix(std::vector<std::string> &arr, int low, int high, int depth, int rank)
 {
     if (high <= low)
         return;
 
-    // Переключаемся на String QuickSort если размер массива меньше размера алфавита
     if (high - low + 1 < ALPHABET_SIZE)
     {
-        ternaryStringQuickSort(arr, low, high, depth);
+        nthElementTernary(arr, low, high, depth, rank);
         return;
     }
 
-    const int R = 256;
-    std::vector<int> count(R + 2, 0);
-    std::vector<std::string> aux(high - low + 1);
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+    distributeByChar(arr, low, high, depth, bucket);
 
-    for (int i = low; i <= high; ++i)
+    // Ранг в корзине закончившихся строк: все они равны, спуск не нужен
+    for (int b = 1; b <= RADIX; ++b)
     {
-        int ch = charAt(arr[i], depth);
-        count[ch + 2]++;
-        comparison_count++;
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
+        if (start <= rank && rank <= end)
+        {
+            nthElementMsdRadix(arr, start, end, depth + 1, rank);
+            return;
+        }
+    }
+}
+
+void StringSortTester::partialSort(std::vector<std::string> &arr, int k)
+{
+    partialMsdRadixSort(arr, 0, static_cast<int>(arr.size()) - 1, 0, k);
+}
+
+void StringSortTester::nthElement(std::vector<std::string> &arr, int rank)
+{
+    nthElementMsdRadix(arr, 0, static_cast<int>(arr.size()) - 1, 0, rank);
+}
+
+// Наименьший общий префикс строк диапазона с arr[low], начиная с позиции depth,
+// или -1, если все строки равны. Строка читается не дальше уже найденного
+// минимума, поэтому проверка стоит не больше одного прохода по общему префиксу
+int StringSortTester::minCommonPrefix(const std::vector<std::string> &arr, int low, int high, int depth)
+{
+    const std::string &first = arr[low];
+    int common = -1;
+
+    for (int i = low + 1; i <= high; ++i)
+    {
+        const std::string &s = arr[i];
+        size_t limit = std::min(s.length(), first.length());
+        if (common >= 0)
+        {
+            limit = std::min(limit, static_cast<size_t>(common));
+        }
+
+        size_t l = depth;
+        while (l < limit)
+        {
+            comparison_count++;
+            bytes_read += 2;
+            if (s[l] != first[l])
+                break;
+            l++;
+        }
+
+        bool equal = common < 0 && l == s.length() && l == first.length();
+        if (!equal && (common < 0 || static_cast<int>(l) < common))
+        {
+            common = static_cast<int>(l);
+        }
     }
 
-    for (int r = 0; r < R + 1; ++r)
+    return common;
+}
+
+// MSD Radix Sort с группировкой. Если все строки попали в одну корзину,
+// распределение не нужно: диапазон либо целиком является группой, либо
+// сразу переходит на позицию, где строки впервые различаются
+void StringSortTester::msdRadixSortDistinct(std::vector<std::string> &arr, int low, int high, int depth,
+                                            std::vector<KeyGroup> &groups)
+{
+    if (high < low)
+        return;
+
+    if (high == low)
     {
-        count[r + 1] += count[r];
+        groups.push_back({low, 1});
+        return;
     }
 
-    for (int i = low; i <= high; ++i)
+    if (high - low + 1 < ALPHABET_SIZE)
     {
-        int ch = charAt(arr[i], depth);
-        aux[count[ch + 1]++] = arr[i];
+        ternaryStringQuickSortDistinct(arr, low, high, depth, groups);
+        return;
     }
 
-    for (int i = low; i <= high; ++i)
+    const int n = high - low + 1;
+    std::vector<int> bucket = countByChar(arr, low, high, depth);
+
+    for (int b = 0; b <= RADIX; ++b)
     {
-        arr[i] = aux[i - low];
+        if (bucket[b + 1] - bucket[b] == n)
+        {
+            int next = b == 0 ? -1 : minCommonPrefix(arr, low, high, depth + 1);
+            if (next < 0)
+            {
+                groups.push_back({low, n});
+            }
+            else
+            {
+                msdRadixSortDistinct(arr, low, high, next, groups);
+            }
+            return;
+        }
     }
 
-    for (int r = 0; r < R; ++r)
+    distributeByChar(arr, low, high, depth, bucket);
+
+    // Строки, закончившиеся на позиции depth, равны между собой
+    if (bucket[1] > 0)
     {
-        int start = low + count[r];
-        int end = low + count[r + 1] - 1;
-        if (start < end)
+        groups.push_back({low, bucket[1]});
+    }
+
+    for (int b = 1; b <= RADIX; ++b)
+    {
+        int start = low + bucket[b];
+        int end = low + bucket[b + 1] - 1;
+        if (start <= end)
         {
-            msdRadixSortWithQuickSort(arr, start, end, depth + 1);
+            msdRadixSortDistinct(arr, start, end, depth + 1, groups);
         }
     }
 }
 
-// Методы тестирования
-SortResult StringSortTester::measurePerformance(
-    std::vector<std::string> arr,
-    std::function<void(std::vector<std::string> &)> sortFunction)
+// Тернарная быстрая сортировка с группировкой: средняя часть с pivot = -1
+// уже является группой, а диапазон без разбиения обрабатывается так же,
+// как одна корзина в msdRadixSortDistinct
+void StringSortTester::ternaryStringQuickSortDistinct(std::vector<std::string> &arr, int low, int high, int depth,
+                                                      std::vector<KeyGroup> &groups)
+{
+    if (high < low)
+        return;
+
+    if (high == low)
+    {
+        groups.push_back({low, 1});
+        return;
+    }
+
+    CharPartition part = partitionByChar(arr, low, high, depth);
+
+    if (part.lt == low && part.gt == high)
+    {
+        int next = part.pivot < 0 ? -1 : minCommonPrefix(arr, low, high, depth + 1);
+        if (next < 0)
+        {
+            groups.push_back({low, high - low + 1});
+        }
+        else
+        {
+            ternaryStringQuickSortDistinct(arr, low, high, next, groups);
+        }
+        return;
+    }
+
+    ternaryStringQuickSortDistinct(arr, low, part.lt - 1, depth, groups);
+    if (part.pivot >= 0)
+    {
+        ternaryStringQuickSortDistinct(arr, part.lt, part.gt, depth + 1, groups);
+    }
+    else
+    {
+        groups.push_back({part.lt, part.gt - part.lt + 1});
+    }
+    ternaryStringQuickSortDistinct(arr, part.gt + 1, high, depth, groups);
+}
+
+// uniq: каждая пара соседей сравнивается целиком, равные - до конца строки
+void StringSortTester::groupAdjacent(const std::vector<std::string> &arr, std::vector<KeyGroup> &groups)
+{
+    for (int i = 0; i < static_cast<int>(arr.size()); ++i)
+    {
+        if (i == 0 || compareStrings(arr[i - 1], arr[i]) != 0)
+        {
+            groups.push_back({i, 1});
+        }
+        else
+        {
+            groups.back().count++;
+        }
+    }
+}
+
+// Группы должны покрывать массив подряд, содержать равные строки
+// и отличаться от соседних групп
+bool StringSortTester::verifyGroups(const std::vector<std::string> &arr, const std::vector<KeyGroup> &groups)
 {
+    size_t next = 0;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        const KeyGroup &group = groups[g];
+        if (group.count <= 0 || static_cast<size_t>(group.begin) != next ||
+            next + group.count > arr.size())
+        {
+            return false;
+        }
+        for (int i = group.begin + 1; i < group.begin + group.count; ++i)
+        {
+            if (arr[i] != arr[group.begin])
+            {
+                return false;
+            }
+        }
+        if (g > 0 && arr[group.begin] == arr[groups[g - 1].begin])
+        {
+            return false;
+        }
+        next += group.count;
+    }
+    return next == arr.size();
+}
+
+std::vector<KeyGroup> StringSortTester::sortDistinct(std::vector<std::string> &arr)
+{
+    std::vector<KeyGroup> groups;
+    msdRadixSortDistinct(arr, 0, static_cast<int>(arr.size()) - 1, 0, groups);
+    return groups;
+}
+
+std::vector<std::pair<std::string, int>> StringSortTester::uniqueWithCounts(const std::vector<std::string> &sorted,
+                                                                            const std::vector<KeyGroup> &groups)
+{
+    std::vector<std::pair<std::string, int>> unique;
+    unique.reserve(groups.size());
+    for (const auto &group : groups)
+    {
+        unique.emplace_back(sorted[group.begin], group.count);
+    }
+    return unique;
+}
+
+// Различающий префикс строки - минимальный префикс, отличающий ее от
+// всех остальных: max(LCP с соседями в отсортированном порядке) + 1,
+// но не длиннее самой строки. D - сумма по всем строкам набора
+DatasetStats StringSortTester::computeDatasetStats(const std::vector<std::string> &arr)
+{
+    DatasetStats stats = {0, 0};
+    std::vector<std::string> sorted = arr;
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<long long> lcp(sorted.size() + 1, 0);
+    for (size_t i = 1; i < sorted.size(); ++i)
+    {
+        const std::string &a = sorted[i - 1];
+        const std::string &b = sorted[i];
+        size_t min_len = std::min(a.length(), b.length());
+        size_t l = 0;
+        while (l < min_len && a[l] == b[l])
+        {
+            l++;
+        }
+        lcp[i] = l;
+    }
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        long long len = sorted[i].length();
+        stats.total_bytes += len;
+        stats.distinguishing_prefix += std::min(len, std::max(lcp[i], lcp[i + 1]) + 1);
+    }
 
+    return stats;
+}
+
+void StringSortTester::resetCounters()
+{
     comparison_count = 0;
+    move_count = 0;
+    bytes_moved = 0;
+    bytes_read = 0;
+    resetPeakRSS();
+}
+
+void StringSortTester::collectCounters(SortResult &result, long long allocations_before)
+{
+    result.character_comparisons = comparison_count;
+    result.bytes_touched = bytes_read + bytes_moved;
+    result.element_moves = move_count;
+    result.allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+    result.peak_rss_kb = readPeakRSS();
+}
+
+// Общий замер прогона для всех режимов: режим добавляет к результату
+// только собственные поля
+template <typename Array>
+SortResult StringSortTester::measureRun(Array &arr, const std::function<void(Array &)> &run,
+                                        const std::function<bool(const Array &)> &orderCheck)
+{
+    MultisetFingerprint input_fingerprint = {};
+    if (verification_enabled)
+    {
+        input_fingerprint = computeFingerprint(arr);
+    }
+
+    resetCounters();
+    long long allocations_before = allocation_count.load(std::memory_order_relaxed);
 
     auto start = std::chrono::high_resolution_clock::now();
-    sortFunction(arr);
+    run(arr);
     auto end = std::chrono::high_resolution_clock::now();
 
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    double execution_time = duration.count() / 1000.0; // Переводим в миллисекунды
 
-    return {execution_time, comparison_count, isSorted(arr)};
+    SortResult result = {};
+    result.execution_time_ms = duration.count() / 1000.0; // Переводим в миллисекунды
+    collectCounters(result, allocations_before);
+
+    // Проверка вне замеряемого участка
+    result.verified = verification_enabled;
+    if (verification_enabled)
+    {
+        result.is_sorted = orderCheck(arr);
+        result.is_permutation = computeFingerprint(arr) == input_fingerprint;
+    }
+    return result;
+}
+
+SortResult StringSortTester::beginTotals()
+{
+    SortResult total = {};
+    total.is_sorted = true;
+    total.is_permutation = true;
+    return total;
+}
+
+void StringSortTester::accumulateResult(SortResult &total, const SortResult &run)
+{
+    total.execution_time_ms += run.execution_time_ms;
+    total.character_comparisons += run.character_comparisons;
+    total.bytes_touched += run.bytes_touched;
+    total.element_moves += run.element_moves;
+    total.allocations += run.allocations;
+    total.peak_rss_kb = std::max(total.peak_rss_kb, run.peak_rss_kb);
+    total.is_sorted = total.is_sorted && run.is_sorted;
+    total.is_permutation = total.is_permutation && run.is_permutation;
+}
+
+// Пиковый RSS остается максимумом, флаги проверки - общими для всех прогонов
+void StringSortTester::finalizeResult(SortResult &total, int num_runs)
+{
+    total.execution_time_ms /= num_runs;
+    total.character_comparisons /= num_runs;
+    total.bytes_touched /= num_runs;
+    total.element_moves /= num_runs;
+    total.allocations /= num_runs;
+    total.verified = verification_enabled;
+}
+
+// Методы тестирования
+SortResult StringSortTester::measurePerformance(
+    std::vector<std::string> arr,
+    std::function<void(std::vector<std::string> &)> sortFunction,
+    std::function<bool(const std::vector<std::string> &)> orderCheck)
+{
+    return measureRun<std::vector<std::string>>(arr, sortFunction, orderCheck ? orderCheck : isSorted);
 }
 
 SortResult StringSortTester::averageResults(
     std::vector<std::string> arr,
     std::function<void(std::vector<std::string> &)> sortFunction,
-    int num_runs)
+    int num_runs,
+    std::function<bool(const std::vector<std::string> &)> orderCheck)
 {
+    SortResult average = beginTotals();
+    for (int i = 0; i < num_runs; ++i)
+    {
+        accumulateResult(average, measurePerformance(arr, sortFunction, orderCheck));
+    }
+    finalizeResult(average, num_runs);
+    return average;
+}
 
-    double total_time = 0.0;
-    long long total_comparisons = 0;
-    bool all_sorted = true;
+KeyValueArray StringSortTester::makeKeyValueArray(const std::vector<std::string> &keys)
+{
+    KeyValueArray arr{keys, std::vector<uint64_t>(keys.size())};
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        arr.payloads[i] = i;
+    }
+    return arr;
+}
 
+KeyValueSortResult StringSortTester::measurePerformanceKV(
+    KeyValueArray arr,
+    std::function<void(KeyValueArray &)> sortFunction)
+{
+    KeyValueSortResult result = {};
+    result.sort = measureRun<KeyValueArray>(arr, sortFunction, [](const KeyValueArray &sorted)
+                                            { return isSorted(sorted.keys); });
+    if (result.sort.verified)
+    {
+        result.is_stable = isStable(arr);
+    }
+    return result;
+}
+
+KeyValueSortResult StringSortTester::averageResultsKV(
+    const std::vector<std::string> &keys,
+    std::function<void(KeyValueArray &)> sortFunction,
+    int num_runs)
+{
+    KeyValueArray records = makeKeyValueArray(keys);
+
+    KeyValueSortResult average = {beginTotals(), true};
     for (int i = 0; i < num_runs; ++i)
     {
-        std::vector<std::string> arr_copy = arr;
-        SortResult result = measurePerformance(arr_copy, sortFunction);
+        KeyValueSortResult result = measurePerformanceKV(records, sortFunction);
+        accumulateResult(average.sort, result.sort);
+        average.is_stable = average.is_stable && result.is_stable;
+    }
+    finalizeResult(average.sort, num_runs);
+    return average;
+}
 
-        total_time += result.execution_time_ms;
-        total_comparisons += result.character_comparisons;
-        all_sorted = all_sorted && result.is_sorted;
+DistinctSortResult StringSortTester::measurePerformanceDistinct(
+    std::vector<std::string> arr,
+    std::function<void(std::vector<std::string> &, std::vector<KeyGroup> &)> sortFunction)
+{
+    std::vector<KeyGroup> groups;
+    groups.reserve(arr.size());
+
+    DistinctSortResult result = {};
+    result.sort = measureRun<std::vector<std::string>>(
+        arr, [&](std::vector<std::string> &a)
+        { sortFunction(a, groups); },
+        isSorted);
+    result.distinct_keys = groups.size();
+    if (result.sort.verified)
+    {
+        result.groups_valid = verifyGroups(arr, groups);
     }
+    return result;
+}
 
-    return {
-        total_time / num_runs,
-        total_comparisons / num_runs,
-        all_sorted};
+DistinctSortResult StringSortTester::averageResultsDistinct(
+    const std::vector<std::string> &arr,
+    std::function<void(std::vector<std::string> &, std::vector<KeyGroup> &)> sortFunction,
+    int num_runs)
+{
+    DistinctSortResult average = {beginTotals(), 0, true};
+    for (int i = 0; i < num_runs; ++i)
+    {
+        DistinctSortResult result = measurePerformanceDistinct(arr, sortFunction);
+        accumulateResult(average.sort, result.sort);
+        average.distinct_keys = result.distinct_keys;
+        average.groups_valid = average.groups_valid && result.groups_valid;
+    }
+    finalizeResult(average.sort, num_runs);
+    return average;
 }
 
 // Методы тестирования конкретных алгоритмов
@@ -431,6 +1298,140 @@ SortResult StringSortTester::testMSDRadixSortWithQuickSort(std::vector<std::stri
                           { msdRadixSortWithQuickSort(a, 0, a.size() - 1, 0); }, 3);
 }
 
+SortResult StringSortTester::testMSDRadixSortStable(std::vector<std::string> arr)
+{
+    return averageResults(arr, [](std::vector<std::string> &a)
+                          { msdRadixSortStable(a, 0, a.size() - 1, 0); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testQuickSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { quickSort(a, 0, a.keys.size() - 1); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testMergeSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { mergeSort(a, 0, a.keys.size() - 1); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testStringQuickSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { ternaryStringQuickSort(a, 0, a.keys.size() - 1, 0); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testStringMergeSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { stringMergeSort(a, 0, a.keys.size() - 1, 0); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testMSDRadixSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { msdRadixSort(a, 0, a.keys.size() - 1, 0); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testMSDRadixSortWithQuickSortKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { msdRadixSortWithQuickSort(a, 0, a.keys.size() - 1, 0); }, 3);
+}
+
+KeyValueSortResult StringSortTester::testMSDRadixSortStableKV(std::vector<std::string> arr)
+{
+    return averageResultsKV(arr, [](KeyValueArray &a)
+                            { msdRadixSortStable(a, 0, a.keys.size() - 1, 0); }, 3);
+}
+
+// std::sort и его частичные варианты с тем же подсчетом посимвольных сравнений
+SortResult StringSortTester::testStdSort(std::vector<std::string> arr)
+{
+    return averageResults(arr, [](std::vector<std::string> &a)
+                          { std::sort(a.begin(), a.end(), [](const std::string &x, const std::string &y)
+                                      { return compareStrings(x, y) < 0; }); }, 3);
+}
+
+SortResult StringSortTester::testPartialStringQuickSort(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { partialTernaryStringQuickSort(a, 0, a.size() - 1, 0, k); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isPartiallySorted(a, k); });
+}
+
+SortResult StringSortTester::testPartialMSDRadixSort(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { partialMsdRadixSort(a, 0, a.size() - 1, 0, k); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isPartiallySorted(a, k); });
+}
+
+SortResult StringSortTester::testStdPartialSort(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { std::partial_sort(a.begin(), a.begin() + k, a.end(),
+                                              [](const std::string &x, const std::string &y)
+                                              { return compareStrings(x, y) < 0; }); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isPartiallySorted(a, k); });
+}
+
+// Выбирается строка ранга k - 1, то есть последняя из первых k
+SortResult StringSortTester::testNthElementStringQuickSort(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { nthElementTernary(a, 0, a.size() - 1, 0, k - 1); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isNthElement(a, k - 1); });
+}
+
+SortResult StringSortTester::testNthElementMSDRadixSort(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { nthElementMsdRadix(a, 0, a.size() - 1, 0, k - 1); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isNthElement(a, k - 1); });
+}
+
+SortResult StringSortTester::testStdNthElement(std::vector<std::string> arr, int k)
+{
+    return averageResults(arr, [k](std::vector<std::string> &a)
+                          { std::nth_element(a.begin(), a.begin() + (k - 1), a.end(),
+                                             [](const std::string &x, const std::string &y)
+                                             { return compareStrings(x, y) < 0; }); }, 3,
+                          [k](const std::vector<std::string> &a)
+                          { return isNthElement(a, k - 1); });
+}
+
+void StringSortTester::sortBatch(std::vector<std::string> &batch)
+{
+    msdRadixSortWithQuickSort(batch, 0, static_cast<int>(batch.size()) - 1, 0);
+}
+
+DistinctSortResult StringSortTester::testSortThenUniq(std::vector<std::string> arr)
+{
+    return averageResultsDistinct(arr, [](std::vector<std::string> &a, std::vector<KeyGroup> &groups)
+                                  {
+        msdRadixSortWithQuickSort(a, 0, a.size() - 1, 0);
+        groupAdjacent(a, groups); }, 3);
+}
+
+DistinctSortResult StringSortTester::testMSDRadixSortDistinct(std::vector<std::string> arr)
+{
+    return averageResultsDistinct(arr, [](std::vector<std::string> &a, std::vector<KeyGroup> &groups)
+                                  { msdRadixSortDistinct(a, 0, a.size() - 1, 0, groups); }, 3);
+}
+
+DistinctSortResult StringSortTester::testStringQuickSortDistinct(std::vector<std::string> arr)
+{
+    return averageResultsDistinct(arr, [](std::vector<std::string> &a, std::vector<KeyGroup> &groups)
+                                  { ternaryStringQuickSortDistinct(a, 0, a.size() - 1, 0, groups); }, 3);
+}
+
 // Утилиты для вывода
 void StringSortTester::printResult(const std::string &algorithm_name, const SortResult &result)
 {
@@ -438,18 +1439,128 @@ void StringSortTester::printResult(const std::string &algorithm_name, const Sort
     std::cout << algorithm_name << ":\n";
     std::cout << "  Время выполнения: " << result.execution_time_ms << " мс\n";
     std::cout << "  Посимвольных сравнений: " << result.character_comparisons << "\n";
-    std::cout << "  Отсортирован: " << (result.is_sorted ? "Да" : "Нет") << "\n\n";
+    std::cout << "  Затронуто байт: " << result.bytes_touched << "\n";
+    std::cout << "  Перемещений строк: " << result.element_moves << "\n";
+    std::cout << "  Пиковый RSS: " << result.peak_rss_kb << " КБ, выделений памяти: " << result.allocations << "\n";
+    if (result.verified)
+    {
+        std::cout << "  Отсортирован: " << (result.is_sorted ? "Да" : "Нет") << "\n";
+        std::cout << "  Перестановка входа: " << (result.is_permutation ? "Да" : "Нет") << "\n\n";
+    }
+    else
+    {
+        std::cout << "  Проверка отключена\n\n";
+    }
+}
+
+// Столбцы проверок через запятую; при отключенной проверке - "skipped"
+void StringSortTester::printCheckColumns(std::ostream &out, bool verified, std::initializer_list<bool> checks)
+{
+    const char *separator = "";
+    for (bool check : checks)
+    {
+        out << separator << (!verified ? "skipped" : check ? "true" : "false");
+        separator = ",";
+    }
+}
+
+void StringSortTester::printCSVHeader(std::ostream &out)
+{
+    out << "Algorithm,ArraySize,ArrayType,ExecutionTime_ms,CharacterComparisons,IsSorted,IsPermutation,"
+        << "DistinguishingPrefix,TotalBytes,BytesTouched,ElementMoves,PeakRSS_KB,Allocations\n";
+}
+
+void StringSortTester::printCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                      const std::string &array_type, const DatasetStats &stats,
+                                      const SortResult &result)
+{
+    out << algorithm_name << "," << array_size << "," << array_type << ","
+        << std::fixed << std::setprecision(3) << result.execution_time_ms << ","
+        << result.character_comparisons << ",";
+    printCheckColumns(out, result.verified, {result.is_sorted, result.is_permutation});
+    out << "," << stats.distinguishing_prefix << "," << stats.total_bytes << ","
+        << result.bytes_touched << "," << result.element_moves << ","
+        << result.peak_rss_kb << "," << result.allocations << "\n";
+}
+
+void StringSortTester::printKeyValueCSVHeader(std::ostream &out)
+{
+    out << "Algorithm,ArraySize,ArrayType,KeyOnlyTime_ms,KeyValueTime_ms,PayloadOverhead,"
+        << "KeyOnlyBytesTouched,KeyValueBytesTouched,IsSorted,IsPermutation,IsStable\n";
+}
+
+// PayloadOverhead - во сколько раз перенос нагрузки замедляет алгоритм
+void StringSortTester::printKeyValueCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                              const std::string &array_type, const SortResult &key_only,
+                                              const KeyValueSortResult &key_value)
+{
+    double overhead = key_only.execution_time_ms > 0
+                          ? key_value.sort.execution_time_ms / key_only.execution_time_ms
+                          : 0.0;
+
+    out << algorithm_name << "," << array_size << "," << array_type << ","
+        << std::fixed << std::setprecision(3) << key_only.execution_time_ms << ","
+        << key_value.sort.execution_time_ms << "," << overhead << ","
+        << key_only.bytes_touched << "," << key_value.sort.bytes_touched << ",";
+    printCheckColumns(out, key_value.sort.verified,
+                      {key_value.sort.is_sorted, key_value.sort.is_permutation, key_value.is_stable});
+    out << "\n";
+}
+
+void StringSortTester::printTopKCSVHeader(std::ostream &out)
+{
+    out << "Algorithm,ArraySize,ArrayType,K,KRatio,ExecutionTime_ms,CharacterComparisons,"
+        << "FullSortTime_ms,SpeedupVsFullSort,IsValid\n";
+}
+
+// SpeedupVsFullSort - отношение времени полной сортировки тем же механизмом
+// ко времени частичного режима
+void StringSortTester::printTopKCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                          const std::string &array_type, int k, const SortResult &result,
+                                          const SortResult &full_sort)
+{
+    double speedup = result.execution_time_ms > 0 ? full_sort.execution_time_ms / result.execution_time_ms : 0.0;
+
+    out << algorithm_name << "," << array_size << "," << array_type << "," << k << ","
+        << std::fixed << std::setprecision(3) << static_cast<double>(k) / array_size << ","
+        << result.execution_time_ms << "," << result.character_comparisons << ","
+        << full_sort.execution_time_ms << "," << speedup << ",";
+    printCheckColumns(out, result.verified, {result.is_sorted && result.is_permutation});
+    out << "\n";
+}
+
+void StringSortTester::printIncrementalCSVHeader(std::ostream &out)
+{
+    out << "Algorithm,ArraySize,ArrayType,InsertTime_ms,InsertsPerSecond,LookupLatency_us,"
+        << "ScanLatency_us,Runs,IsSorted,IsPermutation,QueriesValid\n";
+}
+
+void StringSortTester::printIncrementalCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                                 const std::string &array_type, const IncrementalResult &result)
+{
+    out << algorithm_name << "," << array_size << "," << array_type << ","
+        << std::fixed << std::setprecision(3) << result.insert_time_ms << ","
+        << std::setprecision(0) << result.inserts_per_second << ","
+        << std::setprecision(3) << result.lookup_latency_us << "," << result.scan_latency_us << ","
+        << result.runs << ",";
+    printCheckColumns(out, result.verified, {result.is_sorted, result.is_permutation, result.queries_valid});
+    out << "\n";
 }
 
-void StringSortTester::printCSVHeader()
+void StringSortTester::printDistinctCSVHeader(std::ostream &out)
 {
-    std::cout << "Algorithm,ArraySize,ArrayType,ExecutionTime_ms,CharacterComparisons,IsSorted\n";
+    out << "Algorithm,ArraySize,ArrayType,ExecutionTime_ms,CharacterComparisons,DistinctKeys,"
+        << "BytesTouched,ElementMoves,IsSorted,IsPermutation,GroupsValid\n";
 }
 
-void StringSortTester::printCSVResult(const std::string &algorithm_name, int array_size,
-                                      const std::string &array_type, const SortResult &result)
+void StringSortTester::printDistinctCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                              const std::string &array_type, const DistinctSortResult &result)
 {
-    std::cout << algorithm_name << "," << array_size << "," << array_type << ","
-              << std::fixed << std::setprecision(3) << result.execution_time_ms << ","
-              << result.character_comparisons << "," << (result.is_sorted ? "true" : "false") << "\n";
+    out << algorithm_name << "," << array_size << "," << array_type << ","
+        << std::fixed << std::setprecision(3) << result.sort.execution_time_ms << ","
+        << result.sort.character_comparisons << "," << result.distinct_keys << ","
+        << result.sort.bytes_touched << "," << result.sort.element_moves << ",";
+    printCheckColumns(out, result.sort.verified,
+                      {result.sort.is_sorted, result.sort.is_permutation, result.groups_valid});
+    out << "\n";
 }
@@ -5,44 +5,232 @@
 #include <vector>
 #include <chrono>
 #include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <cstdint>
 
 struct SortResult
 {
     double execution_time_ms;
     long long character_comparisons;
     bool is_sorted;
+    bool is_permutation;             // выход - перестановка входа (совпадение мультимножеств)
+    bool verified;                   // false, если проверка отключена
+    long long bytes_touched;         // прочитанные + скопированные байты
+    long long element_moves;         // перемещения строк (присваивание = 1, обмен = 2)
+    long peak_rss_kb;                // пиковый RSS процесса за прогон
+    long long allocations;           // вызовы operator new за прогон
+};
+
+// Независимый от порядка отпечаток мультимножества строк
+struct MultisetFingerprint
+{
+    size_t count;
+    unsigned long long hash_sum;
+    unsigned long long hash_xor;
+
+    bool operator==(const MultisetFingerprint &other) const
+    {
+        return count == other.count && hash_sum == other.hash_sum && hash_xor == other.hash_xor;
+    }
+};
+
+// Записи "ключ - полезная нагрузка" в раскладке struct-of-arrays:
+// payloads[i] относится к keys[i]
+struct KeyValueArray
+{
+    std::vector<std::string> keys;
+    std::vector<uint64_t> payloads;
+};
+
+// Результат сортировки записей: is_stable проверяется по нагрузке,
+// равной исходной позиции записи
+struct KeyValueSortResult
+{
+    SortResult sort;
+    bool is_stable;
+};
+
+// Группа равных ключей в отсортированном массиве: [begin, begin + count)
+struct KeyGroup
+{
+    int begin;
+    int count;
+};
+
+// Результат сортировки с группировкой равных ключей
+struct DistinctSortResult
+{
+    SortResult sort;
+    long long distinct_keys;
+    bool groups_valid;
+};
+
+// Результат инкрементального режима: строки поступают порциями,
+// после каждой порции выполняются упорядоченные обходы
+struct IncrementalResult
+{
+    double insert_time_ms;     // суммарное время вставки всех порций
+    double inserts_per_second;
+    double lookup_latency_us;  // точечный запрос после вставки всех порций
+    double scan_latency_us;    // обход фиксированного числа строк после каждой порции
+    size_t runs;               // число прогонов в конце (1 для пересортировки)
+    bool is_sorted;
+    bool is_permutation;
+    bool queries_valid;        // обходы непусты, найдены ровно все существующие строки
+    bool verified;
+};
+
+// Характеристики входного набора, не зависящие от алгоритма
+struct DatasetStats
+{
+    long long distinguishing_prefix;
+    long long total_bytes;
 };
 
 class StringSortTester
 {
 private:
     static long long comparison_count;
+    static long long move_count;
+    static long long bytes_moved;
+    static long long bytes_read;
+    static bool verification_enabled;
 
     // Функция для сравнения строк с подсчетом операций
-    static int compareStrings(const std::string &a, const std::string &b);
+    static int compareStrings(const std::string &a, const std::string &b, int depth = 0);
 
-    // Проверка отсортированности массива
-    static bool isSorted(const std::vector<std::string> &arr);
+    // Перемещение и обмен строк с подсчетом операций
+    static void moveString(std::string &dst, const std::string &src);
+    static void swapStrings(std::string &a, std::string &b);
+
+    // Перемещение и обмен записей "ключ - нагрузка"
+    static void moveRecord(KeyValueArray &dst, int i, const KeyValueArray &src, int j);
+    static void swapRecords(KeyValueArray &arr, int i, int j);
+
+    // Единый доступ к массиву строк и массиву записей: все ядра
+    // сортировок пишутся один раз для обеих раскладок
+    static const std::string &keyAt(const std::vector<std::string> &arr, int i);
+    static const std::string &keyAt(const KeyValueArray &arr, int i);
+    static void moveElement(std::vector<std::string> &dst, int i, const std::vector<std::string> &src, int j);
+    static void moveElement(KeyValueArray &dst, int i, const KeyValueArray &src, int j);
+    static void swapElements(std::vector<std::string> &arr, int i, int j);
+    static void swapElements(KeyValueArray &arr, int i, int j);
+    static std::vector<std::string> makeBuffer(const std::vector<std::string> &arr, int n);
+    static KeyValueArray makeBuffer(const KeyValueArray &arr, int n);
+
+    static bool isStable(const KeyValueArray &arr);
+
+    // Первые k строк отсортированы и не больше остальных
+    static bool isPartiallySorted(const std::vector<std::string> &arr, int k);
+    // Строка на позиции rank не меньше всех слева и не больше всех справа
+    static bool isNthElement(const std::vector<std::string> &arr, int rank);
+
+    // Хеш строки и параллельный отпечаток мультимножества
+    static unsigned long long mix64(unsigned long long h);
+    static unsigned long long hashString(const std::string &s);
+    static MultisetFingerprint computeFingerprint(const KeyValueArray &arr);
+
+    // Сброс счетчиков перед прогоном и их сбор после
+    static void resetCounters();
+    static void collectCounters(SortResult &result, long long allocations_before);
+
+    // Общий замер прогона: отпечаток входа, время, счетчики и проверка
+    // порядка и перестановки вне замеряемого участка
+    template <typename Array>
+    static SortResult measureRun(Array &arr, const std::function<void(Array &)> &run,
+                                 const std::function<bool(const Array &)> &orderCheck);
 
-    // Стандартные алгоритмы сортировки
-    static void quickSort(std::vector<std::string> &arr, int low, int high);
-    static int partition(std::vector<std::string> &arr, int low, int high);
-    static void mergeSort(std::vector<std::string> &arr, int left, int right);
-    static void merge(std::vector<std::string> &arr, int left, int mid, int right);
+    // Усреднение прогонов: суммы счетчиков, максимум RSS, общие флаги проверки
+    static SortResult beginTotals();
+    static void accumulateResult(SortResult &total, const SortResult &run);
+    static void finalizeResult(SortResult &total, int num_runs);
+
+    // Столбцы флагов проверки в CSV
+    static void printCheckColumns(std::ostream &out, bool verified, std::initializer_list<bool> checks);
+
+    // Разбиение [0, n) на блоки по потокам
+    static void parallelFor(size_t n, const std::function<void(size_t, size_t)> &body);
+
+    // Сброс и чтение пикового RSS процесса (в КБ)
+    static void resetPeakRSS();
+    static long readPeakRSS();
+
+    // Стандартные алгоритмы сортировки (общие для массива строк и массива записей)
+    template <typename Array>
+    static void quickSort(Array &arr, int low, int high);
+    template <typename Array>
+    static int partition(Array &arr, int low, int high);
+    template <typename Array>
+    static void mergeSort(Array &arr, int left, int right);
+    template <typename Array>
+    static void merge(Array &arr, int left, int mid, int right);
 
     // Специализированные алгоритмы сортировки строк
     static void stringQuickSort(std::vector<std::string> &arr, int low, int high, int depth = 0);
-    static void stringMergeSort(std::vector<std::string> &arr, int left, int right, int depth = 0);
-    static void msdRadixSort(std::vector<std::string> &arr, int low, int high, int depth = 0);
-    static void msdRadixSortWithQuickSort(std::vector<std::string> &arr, int low, int high, int depth = 0);
+    template <typename Array>
+    static void stringMergeSort(Array &arr, int left, int right, int depth = 0);
+    template <typename Array>
+    static void msdRadixSort(Array &arr, int low, int high, int depth = 0);
+    template <typename Array>
+    static void msdRadixSortWithQuickSort(Array &arr, int low, int high, int depth = 0);
+
+    // Устойчивый гибрид: MSD Radix Sort с переключением на сортировку вставками
+    template <typename Array>
+    static void msdRadixSortStable(Array &arr, int low, int high, int depth = 0);
+    template <typename Array>
+    static void insertionSort(Array &arr, int low, int high, int depth);
 
     // Вспомогательные функции для специализированных алгоритмов
     static int charAt(const std::string &s, int index);
     static int getLCP(const std::string &a, const std::string &b, int depth = 0);
-    static void stringMergeWithLCP(std::vector<std::string> &arr, int left, int mid, int right, int depth);
+    template <typename Array>
+    static void stringMergeWithLCP(Array &arr, int left, int mid, int right, int depth);
+
+    // Границы корзин по символу на позиции depth: корзина b (0 - закончившиеся
+    // строки, c + 1 - символ c) занимает [low + bucket[b], low + bucket[b + 1])
+    template <typename Array>
+    static std::vector<int> countByChar(const Array &arr, int low, int high, int depth);
+
+    // Устойчивое распределение диапазона по корзинам, найденным countByChar
+    template <typename Array>
+    static void distributeByChar(Array &arr, int low, int high, int depth, const std::vector<int> &bucket);
+
+    // Тернарное разбиение по символу на позиции depth: [low, lt) меньше pivot,
+    // [lt, gt] равны pivot, (gt, high] больше
+    struct CharPartition
+    {
+        int lt;
+        int gt;
+        int pivot;
+    };
+
+    template <typename Array>
+    static CharPartition partitionByChar(Array &arr, int low, int high, int depth);
 
     // Тернарная быстрая сортировка строк
-    static void ternaryStringQuickSort(std::vector<std::string> &arr, int low, int high, int depth = 0);
+    template <typename Array>
+    static void ternaryStringQuickSort(Array &arr, int low, int high, int depth = 0);
+
+    // Сортировка с выделением групп равных ключей: группа фиксируется, как только
+    // все строки диапазона совпадают, без спуска до конца строк
+    static int minCommonPrefix(const std::vector<std::string> &arr, int low, int high, int depth);
+    static void msdRadixSortDistinct(std::vector<std::string> &arr, int low, int high, int depth,
+                                     std::vector<KeyGroup> &groups);
+    static void ternaryStringQuickSortDistinct(std::vector<std::string> &arr, int low, int high, int depth,
+                                               std::vector<KeyGroup> &groups);
+
+    // Частичная сортировка: рекурсия только в части, пересекающие [0, k)
+    static void partialTernaryStringQuickSort(std::vector<std::string> &arr, int low, int high, int depth, int k);
+    static void partialMsdRadixSort(std::vector<std::string> &arr, int low, int high, int depth, int k);
+
+    // Выбор строки ранга rank: рекурсия только в часть, содержащую rank
+    static void nthElementTernary(std::vector<std::string> &arr, int low, int high, int depth, int rank);
+    static void nthElementMsdRadix(std::vector<std::string> &arr, int low, int high, int depth, int rank);
+
+    // Отдельный проход uniq по отсортированному массиву (базовая линия)
+    static void groupAdjacent(const std::vector<std::string> &arr, std::vector<KeyGroup> &groups);
+    static bool verifyGroups(const std::vector<std::string> &arr, const std::vector<KeyGroup> &groups);
 
 public:
     // Константы для размеров массивов
@@ -50,6 +238,20 @@ public:
     static const int MAX_ARRAY_SIZE = 3000;
     static const int STEP_SIZE = 100;
     static const int ALPHABET_SIZE = 74;
+    static const int RADIX = 256;
+    static const size_t PARALLEL_VERIFY_THRESHOLD = 1 << 14;
+
+    // Сортировка порции ядром MSD Radix Sort с переключением на String QuickSort
+    static void sortBatch(std::vector<std::string> &batch);
+
+    // Включение проверки результата (отключается для замеров пропускной способности)
+    static void setVerification(bool enabled);
+    static bool isVerificationEnabled();
+
+    // Проверка отсортированности (параллельно для больших массивов) и отпечаток
+    // мультимножества - для режимов, которые измеряются вне этого класса
+    static bool isSorted(const std::vector<std::string> &arr);
+    static MultisetFingerprint computeFingerprint(const std::vector<std::string> &arr);
 
     // Методы тестирования стандартных алгоритмов
     static SortResult testQuickSort(std::vector<std::string> arr);
@@ -60,23 +262,100 @@ public:
     static SortResult testStringMergeSort(std::vector<std::string> arr);
     static SortResult testMSDRadixSort(std::vector<std::string> arr);
     static SortResult testMSDRadixSortWithQuickSort(std::vector<std::string> arr);
+    static SortResult testMSDRadixSortStable(std::vector<std::string> arr);
+
+    // Методы тестирования в режиме "ключ - нагрузка"
+    static KeyValueSortResult testQuickSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testMergeSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testStringQuickSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testStringMergeSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testMSDRadixSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testMSDRadixSortWithQuickSortKV(std::vector<std::string> arr);
+    static KeyValueSortResult testMSDRadixSortStableKV(std::vector<std::string> arr);
+
+    // Методы тестирования конвейера "sort + uniq"
+    static DistinctSortResult testSortThenUniq(std::vector<std::string> arr);
+    static DistinctSortResult testMSDRadixSortDistinct(std::vector<std::string> arr);
+    static DistinctSortResult testStringQuickSortDistinct(std::vector<std::string> arr);
+
+    // Методы тестирования частичной сортировки первых k строк и выбора k-й строки
+    static SortResult testStdSort(std::vector<std::string> arr);
+    static SortResult testPartialStringQuickSort(std::vector<std::string> arr, int k);
+    static SortResult testPartialMSDRadixSort(std::vector<std::string> arr, int k);
+    static SortResult testStdPartialSort(std::vector<std::string> arr, int k);
+    static SortResult testNthElementStringQuickSort(std::vector<std::string> arr, int k);
+    static SortResult testNthElementMSDRadixSort(std::vector<std::string> arr, int k);
+    static SortResult testStdNthElement(std::vector<std::string> arr, int k);
+
+    // Сортировка первых k строк и выбор строки ранга rank (MSD Radix + тернарная QuickSort)
+    static void partialSort(std::vector<std::string> &arr, int k);
+    static void nthElement(std::vector<std::string> &arr, int rank);
+
+    // Сортировка с группировкой за один проход и уникальные ключи с количествами
+    static std::vector<KeyGroup> sortDistinct(std::vector<std::string> &arr);
+    static std::vector<std::pair<std::string, int>> uniqueWithCounts(const std::vector<std::string> &sorted,
+                                                                     const std::vector<KeyGroup> &groups);
+
+    // Записи с нагрузкой, равной исходной позиции ключа
+    static KeyValueArray makeKeyValueArray(const std::vector<std::string> &keys);
+
+    // Вычисление D и N для входного набора
+    static DatasetStats computeDatasetStats(const std::vector<std::string> &arr);
 
-    // Общий метод для измерения производительности
+    // Общий метод для измерения производительности. orderCheck заменяет
+    // проверку полной отсортированности (для частичных режимов)
     static SortResult measurePerformance(
         std::vector<std::string> arr,
-        std::function<void(std::vector<std::string> &)> sortFunction);
+        std::function<void(std::vector<std::string> &)> sortFunction,
+        std::function<bool(const std::vector<std::string> &)> orderCheck = nullptr);
 
     // Метод для множественных замеров с усреднением
     static SortResult averageResults(
         std::vector<std::string> arr,
         std::function<void(std::vector<std::string> &)> sortFunction,
+        int num_runs = 5,
+        std::function<bool(const std::vector<std::string> &)> orderCheck = nullptr);
+
+    // Измерение и усреднение в режиме "ключ - нагрузка"
+    static KeyValueSortResult measurePerformanceKV(
+        KeyValueArray arr,
+        std::function<void(KeyValueArray &)> sortFunction);
+
+    static KeyValueSortResult averageResultsKV(
+        const std::vector<std::string> &keys,
+        std::function<void(KeyValueArray &)> sortFunction,
+        int num_runs = 5);
+
+    // Измерение и усреднение сортировки с группировкой
+    static DistinctSortResult measurePerformanceDistinct(
+        std::vector<std::string> arr,
+        std::function<void(std::vector<std::string> &, std::vector<KeyGroup> &)> sortFunction);
+
+    static DistinctSortResult averageResultsDistinct(
+        const std::vector<std::string> &arr,
+        std::function<void(std::vector<std::string> &, std::vector<KeyGroup> &)> sortFunction,
         int num_runs = 5);
 
     // Утилиты для вывода результатов
     static void printResult(const std::string &algorithm_name, const SortResult &result);
-    static void printCSVHeader();
-    static void printCSVResult(const std::string &algorithm_name, int array_size,
-                               const std::string &array_type, const SortResult &result);
+    static void printCSVHeader(std::ostream &out);
+    static void printCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                               const std::string &array_type, const DatasetStats &stats,
+                               const SortResult &result);
+    static void printKeyValueCSVHeader(std::ostream &out);
+    static void printKeyValueCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                       const std::string &array_type, const SortResult &key_only,
+                                       const KeyValueSortResult &key_value);
+    static void printTopKCSVHeader(std::ostream &out);
+    static void printTopKCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                   const std::string &array_type, int k, const SortResult &result,
+                                   const SortResult &full_sort);
+    static void printIncrementalCSVHeader(std::ostream &out);
+    static void printIncrementalCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                          const std::string &array_type, const IncrementalResult &result);
+    static void printDistinctCSVHeader(std::ostream &out);
+    static void printDistinctCSVResult(std::ostream &out, const std::string &algorithm_name, int array_size,
+                                       const std::string &array_type, const DistinctSortResult &result);
 };
 
 #endif // STRING_SORT_TESTER_H
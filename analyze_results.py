@@ -21,6 +21,50 @@ def load_data(csv_file="experiment_results.csv"):
         return None
 
 
+def add_normalized_metrics(df):
+    """Нормировка времени и сравнений на различающий префикс D"""
+    if "DistinguishingPrefix" not in df.columns:
+        return df
+    df = df.copy()
+    df["TimePerD_ns"] = df["ExecutionTime_ms"] * 1e6 / df["DistinguishingPrefix"]
+    df["ComparisonsPerD"] = df["CharacterComparisons"] / df["DistinguishingPrefix"]
+    df["BytesTouchedPerN"] = df["BytesTouched"] / df["TotalBytes"]
+    return df
+
+
+def create_normalized_plots(df):
+    """Графики времени/D и сравнений/D по типам входных данных"""
+
+    plt.style.use("seaborn-v0_8")
+    sns.set_palette("husl")
+
+    fig, axes = plt.subplots(1, 3, figsize=(20, 6))
+    fig.suptitle("Эффективность на единицу работы (D - различающий префикс)", fontsize=16)
+
+    sns.barplot(data=df, x="ArrayType", y="TimePerD_ns", hue="Algorithm", ax=axes[0])
+    axes[0].set_ylabel("Время / D (нс на байт)")
+    axes[0].set_title("Время, нормированное на D")
+    axes[0].set_yscale("log")
+
+    sns.barplot(data=df, x="ArrayType", y="ComparisonsPerD", hue="Algorithm", ax=axes[1])
+    axes[1].set_ylabel("Сравнения / D")
+    axes[1].set_title("Посимвольные сравнения, нормированные на D")
+    axes[1].set_yscale("log")
+
+    sns.barplot(data=df, x="ArrayType", y="BytesTouchedPerN", hue="Algorithm", ax=axes[2])
+    axes[2].set_ylabel("Затронутые байты / N")
+    axes[2].set_title("Трафик по данным строк")
+    axes[2].set_yscale("log")
+
+    for ax in axes:
+        ax.set_xlabel("Тип данных")
+        ax.grid(True, alpha=0.3)
+
+    plt.tight_layout()
+    plt.savefig("normalized_analysis.png", dpi=300, bbox_inches="tight")
+    plt.show()
+
+
 def create_plots(df):
     """Создание графиков для анализа результатов"""
 
@@ -209,6 +253,24 @@ def generate_summary_report(df):
                 scale_factor = (max_time / min_time) / (max_size / min_size)
                 print(f"{algo}: коэффициент масштабирования {scale_factor:.2f}")
 
+    if "ComparisonsPerD" in df.columns:
+        print("\nЭФФЕКТИВНОСТЬ НА ЕДИНИЦУ РАБОТЫ (среднее по размерам):")
+        per_d = (
+            df.groupby(["Algorithm", "ArrayType"])
+            .agg(
+                {
+                    "TimePerD_ns": "mean",
+                    "ComparisonsPerD": "mean",
+                    "BytesTouchedPerN": "mean",
+                    "ElementMoves": "mean",
+                    "PeakRSS_KB": "max",
+                    "Allocations": "mean",
+                }
+            )
+            .round(2)
+        )
+        print(per_d)
+
 
 def main():
     parser = argparse.ArgumentParser(description="Анализ результатов сортировки строк")
@@ -236,12 +298,17 @@ def main():
         print(f"Ошибка: отсутствуют необходимые столбцы: {required_columns}")
         return
 
+    df = add_normalized_metrics(df)
+
     generate_summary_report(df)
 
     if not args.no_plots:
         try:
             create_plots(df)
             print("\nГрафики сохранены в файл 'sorting_analysis.png'")
+            if "TimePerD_ns" in df.columns:
+                create_normalized_plots(df)
+                print("Нормированные графики сохранены в файл 'normalized_analysis.png'")
         except Exception as e:
             print(f"Ошибка при создании графиков: {e}")
 
@@ -0,0 +1,227 @@
+"""
+Сравнение результатов набора для регрессий с базовой линией.
+
+Для каждой ячейки алгоритм x тип данных x размер замеры сравниваются
+односторонним U-критерием Манна-Уитни (нормальное приближение с поправкой
+на связки). Уровни значимости корректируются методом Холма по всем ячейкам.
+
+Замедление считается регрессией, только если одновременно:
+- оно статистически значимо;
+- медиана выросла больше порога;
+- минимальное время выросло больше порога (шум от соседних процессов
+  только увеличивает время, поэтому минимум устойчивее);
+- абсолютный рост медианы больше разрешения таймера.
+
+По умолчанию замеры сравниваются как есть: замедление общего кода (сравнение
+и перемещение строк, обвязка замера) затрагивает все ячейки и должно
+обнаруживаться. С --compensate-drift общее замедление машины (медиана
+отношений медиан по всем ячейкам) делится из текущих замеров; если оно
+превышает порог, об этом выводится предупреждение. Ускорение машины не
+компенсируется: ячейки ускоряются неравномерно, и деление на общий
+коэффициент выдавало бы ложные регрессии.
+
+Использует только стандартную библиотеку Python.
+"""
+
+import argparse
+import json
+import math
+import statistics
+import sys
+
+
+def load_results(path):
+    """Загрузка JSON набора и индексация ячеек"""
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    cells = {
+        (r["algorithm"], r["array_type"], r["array_size"]): r for r in data["results"]
+    }
+    return data["metadata"], cells
+
+
+def mann_whitney_greater(current, baseline):
+    """p-значение гипотезы "current больше baseline" (U-критерий)"""
+    n1, n2 = len(current), len(baseline)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    combined = sorted(
+        [(v, 0) for v in current] + [(v, 1) for v in baseline], key=lambda x: x[0]
+    )
+
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        avg_rank = (i + j) / 2.0 + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = avg_rank
+        t = j - i + 1
+        tie_term += t**3 - t
+        i = j + 1
+
+    rank_sum = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+
+    n = n1 + n2
+    mean_u = n1 * n2 / 2.0
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+
+    z = (u - mean_u - 0.5) / math.sqrt(var_u)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def holm_significant(p_values, alpha):
+    """Поправка Холма: множество индексов, значимых на уровне alpha"""
+    order = sorted(range(len(p_values)), key=lambda i: p_values[i])
+    significant = set()
+    m = len(p_values)
+    for rank, idx in enumerate(order):
+        if p_values[idx] > alpha / (m - rank):
+            break
+        significant.add(idx)
+    return significant
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Сравнение набора с базовой линией")
+    parser.add_argument("baseline", help="JSON базовой линии")
+    parser.add_argument("current", help="JSON текущего прогона")
+    parser.add_argument(
+        "--alpha", type=float, default=0.01, help="Уровень значимости (по всем ячейкам)"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="Порог относительного роста медианы и минимума",
+    )
+    parser.add_argument(
+        "--min-abs-ms",
+        type=float,
+        default=0.02,
+        help="Минимальный абсолютный рост медианы в мс",
+    )
+    parser.add_argument(
+        "--compensate-drift",
+        action="store_true",
+        help="Делить текущие замеры на общее замедление машины (скрывает замедление общего кода)",
+    )
+    parser.add_argument(
+        "--ignore-machine",
+        action="store_true",
+        help="Завершаться с ошибкой даже при несовпадении процессора",
+    )
+    args = parser.parse_args()
+
+    try:
+        base_meta, base_cells = load_results(args.baseline)
+    except FileNotFoundError:
+        print(f"Базовая линия {args.baseline} не найдена. Создайте ее: make bench_baseline")
+        return 1
+    cur_meta, cur_cells = load_results(args.current)
+
+    print(f"Базовая линия: {base_meta.get('git_revision')} ({base_meta.get('timestamp')})")
+    print(f"Текущий прогон: {cur_meta.get('git_revision')} ({cur_meta.get('timestamp')})")
+
+    same_machine = base_meta.get("cpu_model") == cur_meta.get("cpu_model")
+    if not same_machine:
+        print(
+            f"ВНИМАНИЕ: процессоры различаются ({base_meta.get('cpu_model')} / "
+            f"{cur_meta.get('cpu_model')}), сравнение времени ориентировочное"
+        )
+    for key in ("compiler", "compiler_flags", "seed"):
+        if base_meta.get(key) != cur_meta.get(key):
+            print(f"ВНИМАНИЕ: {key} различается: {base_meta.get(key)} / {cur_meta.get(key)}")
+
+    common = [key for key in cur_cells if key in base_cells]
+    ratios = [
+        statistics.median(cur_cells[key]["time_ms"]) / statistics.median(base_cells[key]["time_ms"])
+        for key in common
+        if statistics.median(base_cells[key]["time_ms"]) > 0
+    ]
+    suite_ratio = statistics.median(ratios) if ratios else 1.0
+    drift = max(1.0, suite_ratio) if args.compensate_drift else 1.0
+    print(f"Общее изменение скорости (медиана по ячейкам): x{suite_ratio:.3f}, компенсируется x{drift:.3f}")
+    if drift > 1.0 + args.threshold:
+        print(
+            f"ВНИМАНИЕ: общее замедление {(drift - 1) * 100:.1f}% больше порога и компенсировано; "
+            "замедление общего кода в этом случае не обнаруживается, проверьте без --compensate-drift"
+        )
+
+    failures = []
+    rows = []
+    for key in sorted(cur_cells):
+        cur = cur_cells[key]
+        if not cur["is_sorted"]:
+            failures.append(f"{'/'.join(map(str, key))}: результат не отсортирован")
+        base = base_cells.get(key)
+        if base is None:
+            continue
+        cur_times = [t / drift for t in cur["time_ms"]]
+        base_median = statistics.median(base["time_ms"])
+        cur_median = statistics.median(cur_times)
+        change = cur_median / base_median - 1 if base_median > 0 else 0.0
+        base_min = min(base["time_ms"])
+        min_change = min(cur_times) / base_min - 1 if base_min > 0 else 0.0
+        p_value = mann_whitney_greater(cur_times, base["time_ms"])
+        rows.append((key, base_median, cur_median, change, min_change, p_value))
+
+    significant = holm_significant([row[5] for row in rows], args.alpha)
+
+    print(
+        f"\n{'Ячейка':<52} {'База, мс':>10} {'Сейчас*, мс':>11} {'Изм.':>8} "
+        f"{'Мин.':>8} {'p':>9}"
+    )
+    regressions = []
+    for idx, (key, base_median, cur_median, change, min_change, p_value) in enumerate(rows):
+        is_regression = (
+            idx in significant
+            and change > args.threshold
+            and min_change > args.threshold
+            and cur_median - base_median > args.min_abs_ms
+        )
+        mark = "  РЕГРЕССИЯ" if is_regression else ""
+        name = f"{key[0]} / {key[1]} / {key[2]}"
+        print(
+            f"{name:<52} {base_median:>10.3f} {cur_median:>11.3f} "
+            f"{change * 100:>7.1f}% {min_change * 100:>7.1f}% {p_value:>9.2e}{mark}"
+        )
+        if is_regression:
+            regressions.append(f"{name}: {change * 100:+.1f}% (p = {p_value:.2e})")
+
+    if drift != 1.0:
+        print("* текущие замеры поделены на компенсируемый коэффициент")
+
+    missing = sorted(set(base_cells) - set(cur_cells))
+    if missing:
+        print(f"\nЯчейки базовой линии без текущих замеров: {len(missing)}")
+
+    if failures:
+        print("\nОШИБКИ КОРРЕКТНОСТИ:")
+        for failure in failures:
+            print(f"  {failure}")
+
+    if regressions:
+        print("\nЗНАЧИМЫЕ ЗАМЕДЛЕНИЯ:")
+        for regression in regressions:
+            print(f"  {regression}")
+        if not same_machine and not args.ignore_machine:
+            print("Процессоры различаются, замедления не считаются ошибкой (--ignore-machine)")
+            regressions = []
+
+    if failures or regressions:
+        return 1
+
+    print("\nЗначимых замедлений не обнаружено")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
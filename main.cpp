@@ -1,31 +1,78 @@
 #include "StringGenerator.h"
 #include "StringSortTester.h"
+#include "SortedRunIndex.h"
+#include "BenchmarkSuite.h"
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include <vector>
 #include <string>
 #include <map>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+
+// Режимы эксперимента: каждый пишет результаты в свой CSV файл
+enum class ExperimentMode
+{
+    Sort,
+    KeyValue,
+    Distinct,
+    TopK,
+    Incremental
+};
 
 class ExperimentRunner
 {
 private:
     StringGenerator generator;
+    ExperimentMode mode;
+    std::string csv_path;
     std::ofstream csv_file;
 
-    void runExperimentForSize(int size)
+    std::map<std::string, std::vector<std::string>> generateTestData(int size)
     {
-        std::cout << "Тестирование для размера массива: " << size << std::endl;
-
         auto random_data = generator.generateRandomArray(size);
         auto reverse_sorted_data = generator.generateReverseSortedArray(size);
         auto nearly_sorted_data = generator.generateNearlySortedArray(size);
         auto prefix_based_data = generator.generatePrefixBasedArray(size);
+        auto high_duplicate_data = generator.generateHighDuplicateArray(size);
 
-        std::map<std::string, std::vector<std::string>> test_data = {
+        return {
             {"Random", random_data},
             {"ReverseSorted", reverse_sorted_data},
             {"NearlySorted", nearly_sorted_data},
-            {"PrefixBased", prefix_based_data}};
+            {"PrefixBased", prefix_based_data},
+            {"HighDuplicate", high_duplicate_data}};
+    }
+
+    void runExperimentForSize(int size)
+    {
+        std::cout << "Тестирование для размера массива: " << size << std::endl;
+
+        if (mode == ExperimentMode::KeyValue)
+        {
+            runKeyValueExperimentForSize(size);
+            return;
+        }
+        if (mode == ExperimentMode::Distinct)
+        {
+            runDistinctExperimentForSize(size);
+            return;
+        }
+        if (mode == ExperimentMode::TopK)
+        {
+            runTopKExperimentForSize(size);
+            return;
+        }
+        if (mode == ExperimentMode::Incremental)
+        {
+            runIncrementalExperimentForSize(size);
+            return;
+        }
+
+        std::map<std::string, std::vector<std::string>> test_data = generateTestData(size);
 
         std::vector<std::pair<std::string, std::function<SortResult(std::vector<std::string>)>>> algorithms = {
             {"QuickSort", StringSortTester::testQuickSort},
@@ -39,6 +86,7 @@ private:
         {
             const std::string &data_type = data_pair.first;
             const std::vector<std::string> &data = data_pair.second;
+            DatasetStats stats = StringSortTester::computeDatasetStats(data);
 
             std::cout << "  Тип данных: " << data_type << std::endl;
 
@@ -54,12 +102,19 @@ private:
 
                     std::cout << "    " << algo_name << ": "
                               << result.execution_time_ms << " мс, "
-                              << result.character_comparisons << " сравнений" << std::endl;
+                              << result.character_comparisons << " сравнений, "
+                              << static_cast<double>(result.character_comparisons) / stats.distinguishing_prefix
+                              << " сравнений/D" << std::endl;
 
-                    csv_file << algo_name << "," << size << "," << data_type << ","
-                             << std::fixed << std::setprecision(3) << result.execution_time_ms << ","
-                             << result.character_comparisons << ","
-                             << (result.is_sorted ? "true" : "false") << std::endl;
+                    if (result.verified && !(result.is_sorted && result.is_permutation))
+                    {
+                        std::cerr << "    Ошибка проверки " << algo_name << ": "
+                                  << (result.is_sorted ? "" : "нарушен порядок ")
+                                  << (result.is_permutation ? "" : "потеряны или продублированы строки")
+                                  << std::endl;
+                    }
+
+                    StringSortTester::printCSVResult(csv_file, algo_name, size, data_type, stats, result);
                 }
                 catch (const std::exception &e)
                 {
@@ -70,11 +125,447 @@ private:
         std::cout << std::endl;
     }
 
-public:
-    ExperimentRunner() : csv_file("experiment_results.csv")
+    // Каждый алгоритм сортирует те же ключи без нагрузки и с 64-битной нагрузкой
+    void runKeyValueExperimentForSize(int size)
+    {
+        std::map<std::string, std::vector<std::string>> test_data = generateTestData(size);
+
+        struct KeyValueAlgorithm
+        {
+            std::string name;
+            std::function<SortResult(std::vector<std::string>)> key_only;
+            std::function<KeyValueSortResult(std::vector<std::string>)> key_value;
+        };
+
+        std::vector<KeyValueAlgorithm> algorithms = {
+            {"QuickSort", StringSortTester::testQuickSort, StringSortTester::testQuickSortKV},
+            {"MergeSort", StringSortTester::testMergeSort, StringSortTester::testMergeSortKV},
+            {"StringQuickSort", StringSortTester::testStringQuickSort, StringSortTester::testStringQuickSortKV},
+            {"StringMergeSort", StringSortTester::testStringMergeSort, StringSortTester::testStringMergeSortKV},
+            {"MSDRadixSort", StringSortTester::testMSDRadixSort, StringSortTester::testMSDRadixSortKV},
+            {"MSDRadixSortWithQuickSort", StringSortTester::testMSDRadixSortWithQuickSort,
+             StringSortTester::testMSDRadixSortWithQuickSortKV},
+            {"MSDRadixSortStable", StringSortTester::testMSDRadixSortStable,
+             StringSortTester::testMSDRadixSortStableKV}};
+
+        for (const auto &data_pair : test_data)
+        {
+            const std::string &data_type = data_pair.first;
+            const std::vector<std::string> &data = data_pair.second;
+
+            std::cout << "  Тип данных: " << data_type << std::endl;
+
+            for (const auto &algo : algorithms)
+            {
+                try
+                {
+                    SortResult key_only = algo.key_only(data);
+                    KeyValueSortResult key_value = algo.key_value(data);
+
+                    std::cout << "    " << algo.name << ": "
+                              << key_only.execution_time_ms << " мс -> "
+                              << key_value.sort.execution_time_ms << " мс с нагрузкой"
+                              << (key_value.sort.verified && key_value.is_stable ? ", устойчиво" : "")
+                              << std::endl;
+
+                    if (key_value.sort.verified && !(key_value.sort.is_sorted && key_value.sort.is_permutation))
+                    {
+                        std::cerr << "    Ошибка проверки " << algo.name << ": нарушен порядок или связь ключ-нагрузка"
+                                  << std::endl;
+                    }
+
+                    StringSortTester::printKeyValueCSVResult(csv_file, algo.name, size, data_type,
+                                                             key_only, key_value);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "    Ошибка при тестировании " << algo.name << ": " << e.what() << std::endl;
+                }
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    // Конвейер "sort + uniq": полная сортировка с отдельным проходом uniq
+    // против сортировок, выдающих группы равных ключей за один проход
+    void runDistinctExperimentForSize(int size)
+    {
+        std::map<std::string, std::vector<std::string>> test_data = generateTestData(size);
+
+        std::vector<std::pair<std::string, std::function<DistinctSortResult(std::vector<std::string>)>>> algorithms = {
+            {"SortThenUniq", StringSortTester::testSortThenUniq},
+            {"MSDRadixSortDistinct", StringSortTester::testMSDRadixSortDistinct},
+            {"StringQuickSortDistinct", StringSortTester::testStringQuickSortDistinct}};
+
+        for (const auto &data_pair : test_data)
+        {
+            const std::string &data_type = data_pair.first;
+            const std::vector<std::string> &data = data_pair.second;
+
+            std::cout << "  Тип данных: " << data_type << std::endl;
+
+            for (const auto &algo_pair : algorithms)
+            {
+                const std::string &algo_name = algo_pair.first;
+                const auto &algo_function = algo_pair.second;
+
+                try
+                {
+                    DistinctSortResult result = algo_function(data);
+
+                    std::cout << "    " << algo_name << ": "
+                              << result.sort.execution_time_ms << " мс, "
+                              << result.sort.character_comparisons << " сравнений, "
+                              << result.distinct_keys << " уникальных ключей" << std::endl;
+
+                    if (result.sort.verified && !(result.sort.is_sorted && result.sort.is_permutation && result.groups_valid))
+                    {
+                        std::cerr << "    Ошибка проверки " << algo_name << ": неверный порядок или группы" << std::endl;
+                    }
+
+                    StringSortTester::printDistinctCSVResult(csv_file, algo_name, size, data_type, result);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "    Ошибка при тестировании " << algo_name << ": " << e.what() << std::endl;
+                }
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    // Частичная сортировка первых k строк и выбор k-й строки против полной
+    // сортировки тем же механизмом для разных отношений k/n
+    void runTopKExperimentForSize(int size)
+    {
+        static const double K_RATIOS[] = {0.001, 0.01, 0.1, 0.5, 1.0};
+
+        std::map<std::string, std::vector<std::string>> test_data = generateTestData(size);
+
+        struct TopKAlgorithm
+        {
+            std::string name;
+            std::string full_sort_name;
+            std::function<SortResult(std::vector<std::string>, int)> partial;
+        };
+
+        std::vector<std::pair<std::string, std::function<SortResult(std::vector<std::string>)>>> full_sorts = {
+            {"StringQuickSort", StringSortTester::testStringQuickSort},
+            {"MSDRadixSortWithQuickSort", StringSortTester::testMSDRadixSortWithQuickSort},
+            {"StdSort", StringSortTester::testStdSort}};
+
+        std::vector<TopKAlgorithm> algorithms = {
+            {"PartialStringQuickSort", "StringQuickSort", StringSortTester::testPartialStringQuickSort},
+            {"PartialMSDRadixSort", "MSDRadixSortWithQuickSort", StringSortTester::testPartialMSDRadixSort},
+            {"StdPartialSort", "StdSort", StringSortTester::testStdPartialSort},
+            {"NthElementStringQuickSort", "StringQuickSort", StringSortTester::testNthElementStringQuickSort},
+            {"NthElementMSDRadixSort", "MSDRadixSortWithQuickSort", StringSortTester::testNthElementMSDRadixSort},
+            {"StdNthElement", "StdSort", StringSortTester::testStdNthElement}};
+
+        for (const auto &data_pair : test_data)
+        {
+            const std::string &data_type = data_pair.first;
+            const std::vector<std::string> &data = data_pair.second;
+
+            std::cout << "  Тип данных: " << data_type << std::endl;
+
+            std::map<std::string, SortResult> full_results;
+            for (const auto &full_pair : full_sorts)
+            {
+                full_results[full_pair.first] = full_pair.second(data);
+            }
+
+            for (double ratio : K_RATIOS)
+            {
+                int k = std::max(1, static_cast<int>(std::lround(ratio * size)));
+
+                for (const auto &algo : algorithms)
+                {
+                    try
+                    {
+                        SortResult result = algo.partial(data, k);
+                        const SortResult &full_sort = full_results[algo.full_sort_name];
+
+                        std::cout << "    " << algo.name << " (k = " << k << "): "
+                                  << result.execution_time_ms << " мс против "
+                                  << full_sort.execution_time_ms << " мс полной сортировки" << std::endl;
+
+                        if (result.verified && !(result.is_sorted && result.is_permutation))
+                        {
+                            std::cerr << "    Ошибка проверки " << algo.name << " (k = " << k << ")" << std::endl;
+                        }
+
+                        StringSortTester::printTopKCSVResult(csv_file, algo.name, size, data_type, k,
+                                                             result, full_sort);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        std::cerr << "    Ошибка при тестировании " << algo.name << ": " << e.what() << std::endl;
+                    }
+                }
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    // Параметры инкрементального режима
+    static const int INCREMENTAL_BATCHES = 20;
+    static const int SCAN_LENGTH = 100;
+    static const int NUM_QUERIES = 1000;
+
+    // Запросы: четные - существующие строки, нечетные - отсутствующие
+    // (с добавленным символом вне алфавита); обходы начинаются с существующих строк
+    static std::vector<std::string> makeLookupQueries(const std::vector<std::string> &arr)
+    {
+        std::vector<std::string> queries;
+        queries.reserve(NUM_QUERIES);
+        for (int q = 0; q < NUM_QUERIES; ++q)
+        {
+            const std::string &key = arr[(static_cast<size_t>(q) * 7919) % arr.size()];
+            queries.push_back(q % 2 == 0 ? key : key + "~");
+        }
+        return queries;
+    }
+
+    // Проверка вне замеров: порядок и состав итогового массива отдельно
+    // от корректности обходов и точечных запросов
+    // Посетитель обхода, общий для обоих индексов: читает каждую строку и
+    // отмечает, если обход выдал строку меньше from
+    static std::function<bool(const std::string &)> makeScanVisitor(const std::string &from, int &remaining,
+                                                                     bool &in_range)
     {
+        return [&from, &remaining, &in_range](const std::string &key)
+        {
+            in_range &= key.compare(from) >= 0;
+            return --remaining > 0;
+        };
+    }
+
+    // Обход отсортированного массива с тем же контрактом, что SortedRunIndex::scanFrom
+    static size_t scanSorted(const std::vector<std::string> &sorted, const std::string &from,
+                             const std::function<bool(const std::string &)> &visitor)
+    {
+        size_t visited = 0;
+        for (auto it = std::lower_bound(sorted.begin(), sorted.end(), from); it != sorted.end(); ++it)
+        {
+            visited++;
+            if (!visitor(*it))
+            {
+                break;
+            }
+        }
+        return visited;
+    }
+
+    static void verifyIncremental(IncrementalResult &result, const std::vector<std::string> &ordered,
+                                  const std::vector<std::string> &arr, size_t visited_total, bool scans_in_range,
+                                  size_t found)
+    {
+        result.verified = true;
+        result.is_sorted = StringSortTester::isSorted(ordered);
+        result.is_permutation = StringSortTester::computeFingerprint(ordered) ==
+                                StringSortTester::computeFingerprint(arr);
+        result.queries_valid = visited_total > 0 && scans_in_range && found == static_cast<size_t>((NUM_QUERIES + 1) / 2);
+    }
+
+    static IncrementalResult testIncrementalRunIndex(const std::vector<std::string> &arr)
+    {
+        const size_t batch_size = std::max<size_t>(1, arr.size() / INCREMENTAL_BATCHES);
+        std::vector<std::string> queries = makeLookupQueries(arr);
+
+        SortedRunIndex index;
+        double insert_us = 0.0, scan_us = 0.0;
+        size_t visited_total = 0;
+        bool scans_in_range = true;
 
-        csv_file << "Algorithm,ArraySize,ArrayType,ExecutionTime_ms,CharacterComparisons,IsSorted" << std::endl;
+        for (size_t begin = 0; begin < arr.size(); begin += batch_size)
+        {
+            std::vector<std::string> batch(arr.begin() + begin, arr.begin() + std::min(arr.size(), begin + batch_size));
+
+            auto start = std::chrono::high_resolution_clock::now();
+            index.insertBatch(std::move(batch));
+            auto end = std::chrono::high_resolution_clock::now();
+            insert_us += std::chrono::duration<double, std::micro>(end - start).count();
+
+            const std::string &from = arr[(begin * 31) % arr.size()];
+            int remaining = SCAN_LENGTH;
+            auto visitor = makeScanVisitor(from, remaining, scans_in_range);
+            start = std::chrono::high_resolution_clock::now();
+            visited_total += index.scanFrom(from, visitor);
+            end = std::chrono::high_resolution_clock::now();
+            scan_us += std::chrono::duration<double, std::micro>(end - start).count();
+        }
+
+        size_t found = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto &query : queries)
+        {
+            found += index.contains(query);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double lookup_us = std::chrono::duration<double, std::micro>(end - start).count();
+
+        size_t num_batches = (arr.size() + batch_size - 1) / batch_size;
+
+        IncrementalResult result = {};
+        result.insert_time_ms = insert_us / 1000.0;
+        result.inserts_per_second = insert_us > 0 ? arr.size() / (insert_us / 1e6) : 0.0;
+        result.lookup_latency_us = lookup_us / queries.size();
+        result.scan_latency_us = scan_us / num_batches;
+        result.runs = index.runCount();
+
+        if (StringSortTester::isVerificationEnabled())
+        {
+            verifyIncremental(result, index.snapshot(), arr, visited_total, scans_in_range, found);
+        }
+        return result;
+    }
+
+    static IncrementalResult testIncrementalResort(const std::vector<std::string> &arr)
+    {
+        const size_t batch_size = std::max<size_t>(1, arr.size() / INCREMENTAL_BATCHES);
+        std::vector<std::string> queries = makeLookupQueries(arr);
+
+        std::vector<std::string> sorted;
+        double insert_us = 0.0, scan_us = 0.0;
+        size_t visited_total = 0;
+        bool scans_in_range = true;
+
+        for (size_t begin = 0; begin < arr.size(); begin += batch_size)
+        {
+            std::vector<std::string> batch(arr.begin() + begin, arr.begin() + std::min(arr.size(), begin + batch_size));
+
+            auto start = std::chrono::high_resolution_clock::now();
+            sorted.insert(sorted.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            StringSortTester::sortBatch(sorted);
+            auto end = std::chrono::high_resolution_clock::now();
+            insert_us += std::chrono::duration<double, std::micro>(end - start).count();
+
+            const std::string &from = arr[(begin * 31) % arr.size()];
+            int remaining = SCAN_LENGTH;
+            auto visitor = makeScanVisitor(from, remaining, scans_in_range);
+            start = std::chrono::high_resolution_clock::now();
+            visited_total += scanSorted(sorted, from, visitor);
+            end = std::chrono::high_resolution_clock::now();
+            scan_us += std::chrono::duration<double, std::micro>(end - start).count();
+        }
+
+        size_t found = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto &query : queries)
+        {
+            found += std::binary_search(sorted.begin(), sorted.end(), query);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double lookup_us = std::chrono::duration<double, std::micro>(end - start).count();
+
+        size_t num_batches = (arr.size() + batch_size - 1) / batch_size;
+
+        IncrementalResult result = {};
+        result.insert_time_ms = insert_us / 1000.0;
+        result.inserts_per_second = insert_us > 0 ? arr.size() / (insert_us / 1e6) : 0.0;
+        result.lookup_latency_us = lookup_us / queries.size();
+        result.scan_latency_us = scan_us / num_batches;
+        result.runs = 1;
+
+        if (StringSortTester::isVerificationEnabled())
+        {
+            verifyIncremental(result, sorted, arr, visited_total, scans_in_range, found);
+        }
+        return result;
+    }
+
+    // Строки поступают порциями по size / INCREMENTAL_BATCHES
+    void runIncrementalExperimentForSize(int size)
+    {
+        std::map<std::string, std::vector<std::string>> test_data = generateTestData(size);
+
+        std::vector<std::pair<std::string, std::function<IncrementalResult(const std::vector<std::string> &)>>> algorithms = {
+            {"SortedRunIndex", testIncrementalRunIndex},
+            {"ResortAll", testIncrementalResort}};
+
+        for (const auto &data_pair : test_data)
+        {
+            const std::string &data_type = data_pair.first;
+            const std::vector<std::string> &data = data_pair.second;
+
+            std::cout << "  Тип данных: " << data_type << std::endl;
+
+            for (const auto &algo_pair : algorithms)
+            {
+                const std::string &algo_name = algo_pair.first;
+                const auto &algo_function = algo_pair.second;
+
+                try
+                {
+                    IncrementalResult result = algo_function(data);
+
+                    std::cout << "    " << algo_name << ": "
+                              << result.inserts_per_second << " вставок/с, запрос "
+                              << result.lookup_latency_us << " мкс, обход "
+                              << result.scan_latency_us << " мкс, прогонов: " << result.runs << std::endl;
+
+                    if (result.verified && !(result.is_sorted && result.is_permutation))
+                    {
+                        std::cerr << "    Ошибка проверки " << algo_name << ": индекс не упорядочен или неполон" << std::endl;
+                    }
+                    if (result.verified && !result.queries_valid)
+                    {
+                        std::cerr << "    Ошибка проверки " << algo_name << ": неверный результат обхода или запроса" << std::endl;
+                    }
+
+                    StringSortTester::printIncrementalCSVResult(csv_file, algo_name, size, data_type, result);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "    Ошибка при тестировании " << algo_name << ": " << e.what() << std::endl;
+                }
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    static std::string csvPathFor(ExperimentMode mode)
+    {
+        switch (mode)
+        {
+        case ExperimentMode::KeyValue:
+            return "kv_results.csv";
+        case ExperimentMode::Distinct:
+            return "distinct_results.csv";
+        case ExperimentMode::TopK:
+            return "topk_results.csv";
+        case ExperimentMode::Incremental:
+            return "incremental_results.csv";
+        default:
+            return "experiment_results.csv";
+        }
+    }
+
+public:
+    explicit ExperimentRunner(ExperimentMode mode = ExperimentMode::Sort)
+        : mode(mode),
+          csv_path(csvPathFor(mode)),
+          csv_file(csv_path)
+    {
+        switch (mode)
+        {
+        case ExperimentMode::KeyValue:
+            StringSortTester::printKeyValueCSVHeader(csv_file);
+            break;
+        case ExperimentMode::Distinct:
+            StringSortTester::printDistinctCSVHeader(csv_file);
+            break;
+        case ExperimentMode::TopK:
+            StringSortTester::printTopKCSVHeader(csv_file);
+            break;
+        case ExperimentMode::Incremental:
+            StringSortTester::printIncrementalCSVHeader(csv_file);
+            break;
+        default:
+            StringSortTester::printCSVHeader(csv_file);
+            break;
+        }
     }
 
     ~ExperimentRunner()
@@ -91,7 +582,7 @@ public:
         std::cout << "Размеры массивов: от " << StringSortTester::MIN_ARRAY_SIZE
                   << " до " << StringSortTester::MAX_ARRAY_SIZE
                   << " с шагом " << StringSortTester::STEP_SIZE << std::endl;
-        std::cout << "Результаты будут сохранены в файл experiment_results.csv" << std::endl
+        std::cout << "Результаты будут сохранены в файл " << csv_path << std::endl
                   << std::endl;
 
         for (int size = StringSortTester::MIN_ARRAY_SIZE;
@@ -101,7 +592,7 @@ public:
             runExperimentForSize(size);
         }
 
-        std::cout << "Эксперимент завершен! Результаты сохранены в experiment_results.csv" << std::endl;
+        std::cout << "Эксперимент завершен! Результаты сохранены в " << csv_path << std::endl;
     }
 
     void runQuickTest()
@@ -116,9 +607,80 @@ int main(int argc, char *argv[])
     std::cout << "=== Исследование алгоритмов сортировки строк ===" << std::endl
               << std::endl;
 
-    ExperimentRunner runner;
+    bool quick = false;
+    bool bench = false;
+    unsigned int seed = BenchmarkSuite::DEFAULT_SEED;
+    int repetitions = BenchmarkSuite::DEFAULT_REPETITIONS;
+    std::string json_path = "bench_results.json";
+    ExperimentMode mode = ExperimentMode::Sort;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--bench")
+        {
+            bench = true;
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--repetitions" && i + 1 < argc)
+        {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else if (arg == "--quick")
+        {
+            quick = true;
+        }
+        else if (arg == "--no-verify")
+        {
+            StringSortTester::setVerification(false);
+        }
+        else if (arg == "--kv")
+        {
+            mode = ExperimentMode::KeyValue;
+        }
+        else if (arg == "--distinct")
+        {
+            mode = ExperimentMode::Distinct;
+        }
+        else if (arg == "--topk")
+        {
+            mode = ExperimentMode::TopK;
+        }
+        else if (arg == "--incremental")
+        {
+            mode = ExperimentMode::Incremental;
+        }
+    }
+
+    if (bench)
+    {
+        // Проверка идет вне замеров, а без нее поле is_sorted в JSON было бы пустым обещанием
+        if (!StringSortTester::isVerificationEnabled())
+        {
+            std::cerr << "--no-verify несовместим с --bench: набор всегда проверяет результат" << std::endl;
+            return 1;
+        }
+
+        BenchmarkSuite suite(seed, repetitions);
+        suite.run();
+        if (!suite.saveJSON(json_path))
+        {
+            std::cerr << "Не удалось записать " << json_path << std::endl;
+            return 1;
+        }
+        std::cout << "Результаты набора сохранены в " << json_path << std::endl;
+        return 0;
+    }
+
+    ExperimentRunner runner(mode);
 
-    if (argc > 1 && std::string(argv[1]) == "--quick")
+    if (quick)
     {
         runner.runQuickTest();
     }